@@ -25,8 +25,30 @@
 #ifndef INC_HG_COLOR_H_
 #define INC_HG_COLOR_H_
 
+#include <stdbool.h>
+
 #define COLOR_UNDEF -1
 
+//
+// The ids of the created colors start with an offset, to keep the predefined
+// ncurses colors. COLOR_ID_MAX is the upper bound of all color ids.
+//
+#define COLOR_START 8
+
+#define COLOR_MAX 64
+
+#define COLOR_ID_MAX (COLOR_START + COLOR_MAX)
+
+//
+// In headless mode the colors and color pairs are only registered. They are
+// not initialized with ncurses, which requires a terminal.
+//
+extern bool _col_headless;
+
+#define col_set_headless(h) _col_headless = (h)
+
 short col_color_create(const short r, const short g, const short b);
 
+void col_color_reset();
+
 #endif /* INC_HG_COLOR_H_ */
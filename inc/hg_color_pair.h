@@ -25,8 +25,53 @@
 #ifndef RES_HG_COLOR_H_
 #define RES_HG_COLOR_H_
 
+#include "hg_common.h"
+#include "hg_color.h"
+#include "hg_metrics.h"
+
+/******************************************************************************
+ * The lookup table maps a foreground and a background color to the color
+ * pair. Color pairs start with CP_START, so an entry with CP_UNDEF is not
+ * registered yet.
+ *****************************************************************************/
+
+#define CP_UNDEF 0
+
+extern short _cp_table[COLOR_ID_MAX][COLOR_ID_MAX];
+
+/******************************************************************************
+ * The function definitions.
+ *****************************************************************************/
+
 short cp_color_pair_add(const short fg, const short bg);
 
 short cp_color_pair_get(const short fg, const short bg);
 
+void cp_color_pair_reset();
+
+/******************************************************************************
+ * The function returns the color pair from the lookup table. Only if the color
+ * pair is not registered, cp_color_pair_get() is called, which adds it. The
+ * lookups are counted by the metrics.
+ *****************************************************************************/
+
+static inline short cp_color_pair_lookup(const short fg, const short bg) {
+
+#ifdef DEBUG
+
+	//
+	// Ensure that the colors are valid table indices.
+	//
+	if (fg < 0 || fg >= COLOR_ID_MAX || bg < 0 || bg >= COLOR_ID_MAX) {
+		log_exit("Invalid colors fg: %d bg: %d", fg, bg);
+	}
+#endif
+
+	metrics_add(cp_lookups, 1);
+
+	const short cp = _cp_table[fg][bg];
+
+	return cp != CP_UNDEF ? cp : cp_color_pair_get(fg, bg);
+}
+
 #endif /* RES_HG_COLOR_H_ */
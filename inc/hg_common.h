@@ -96,6 +96,53 @@ typedef struct s_point {
 //
 #define bool_str(b) ((b) ? "true" : "false")
 
+//
+// The size of a cache line, which is used for the alignment of large arrays.
+//
+#define CACHE_LINE 64
+
 void* xmalloc(const size_t size);
 
+void* xmalloc_aligned(const size_t size);
+
+/******************************************************************************
+ * The arena is a bump pointer allocator for data that lives for a short time,
+ * like a turn. The memory is not released element by element, but all at once
+ * with arena_reset(). If a block is exhausted, a new block is added. The reset
+ * replaces the blocks with a single block that is large enough for all the
+ * allocations, so after a warm-up no more memory is allocated.
+ *****************************************************************************/
+
+typedef struct s_arena {
+
+	//
+	// The current block. The first bytes of a block are a pointer to the
+	// previous block.
+	//
+	char *mem;
+
+	size_t size;
+
+	size_t used;
+
+	//
+	// The number of bytes allocated since the last reset.
+	//
+	size_t total;
+
+} s_arena;
+
+void arena_init(s_arena *arena);
+
+void* arena_alloc(s_arena *arena, const size_t size);
+
+void arena_reset(s_arena *arena);
+
+void arena_free(s_arena *arena);
+
+//
+// The arena for the data of a turn, which is reset at the end of the turn.
+//
+extern s_arena _arena_turn;
+
 #endif /* INC_HG_COMMON_H_ */
@@ -0,0 +1,89 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_HG_CUBE_H_
+#define INC_HG_CUBE_H_
+
+#include "hg_common.h"
+#include "hg_dir.h"
+
+/******************************************************************************
+ * The s_cube struct represents a hex field in cube coordinates. The game uses
+ * offset coordinates (s_point with row and column), where the odd columns are
+ * shifted down by half a hex field. In cube coordinates the hex fields are on
+ * the plane q + r + s = 0, so distances, rings, lines and rotations are simple
+ * arithmetic without special cases for the parity. The conversion happens at
+ * the boundaries.
+ *
+ * The q axis is the column and s is redundant (axial coordinates are q and r).
+ *****************************************************************************/
+
+typedef struct s_cube {
+
+	int q;
+
+	int r;
+
+	int s;
+
+} s_cube;
+
+//
+// The macro sets the axial coordinates and computes s.
+//
+#define s_cube_set(c,q_,r_) (c)->q = (q_); (c)->r = (r_); (c)->s = -(q_) - (r_)
+
+#define s_cube_same(c1,c2) ((c1)->q == (c2)->q && (c1)->r == (c2)->r)
+
+//
+// The number of hex fields of a ring and a spiral (filled hexagon) with a
+// given radius.
+//
+#define cube_ring_num(n) ((n) == 0 ? 1 : 6 * (n))
+
+#define cube_spiral_num(n) (1 + 3 * (n) * ((n) + 1))
+
+/******************************************************************************
+ * The definitions of the functions.
+ *****************************************************************************/
+
+void cube_from_offset(const s_point *offset, s_cube *cube);
+
+void cube_to_offset(const s_cube *cube, s_point *offset);
+
+int cube_distance(const s_cube *cube_1, const s_cube *cube_2);
+
+int cube_offset_distance(const s_point *offset_1, const s_point *offset_2);
+
+void cube_neighbour(const s_cube *from, const e_dir dir, s_cube *to);
+
+void cube_rotate(const s_cube *center, const s_cube *from, const int steps, s_cube *to);
+
+int cube_ring(const s_cube *center, const int radius, s_cube *ring);
+
+int cube_spiral(const s_cube *center, const int radius, s_cube *spiral);
+
+int cube_line(const s_cube *from, const s_cube *to, s_cube *line);
+
+#endif /* INC_HG_CUBE_H_ */
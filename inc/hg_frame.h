@@ -0,0 +1,78 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_HG_FRAME_H_
+#define INC_HG_FRAME_H_
+
+#include "hg_common.h"
+#include "hg_target.h"
+
+/******************************************************************************
+ * The frame is an off-screen buffer of cells. The current cells are the cells
+ * that are composed for the next flush. The previous cells are the cells that
+ * were flushed to the render target, which means they are the content of the
+ * target.
+ *****************************************************************************/
+
+typedef struct {
+
+	s_point dim;
+
+	s_cell *cur;
+
+	s_cell *prev;
+
+} s_frame;
+
+/******************************************************************************
+ * Definition of the macros.
+ *****************************************************************************/
+
+#define frame_cell(f,c,r,k) (&(c)[(r) * (f)->dim.col + (k)])
+
+#define frame_cell_same(c1,c2) ((c1)->chr == (c2)->chr && (c1)->cp == (c2)->cp)
+
+//
+// The macro sets a cell of the current frame. The cell has to be inside the
+// frame.
+//
+#define frame_set(f,r,k,h,p) frame_cell(f,(f)->cur,r,k)->chr = (h); frame_cell(f,(f)->cur,r,k)->cp = (p)
+
+#define frame_inside(f,r,k) (0 <= (r) && (r) < (f)->dim.row && 0 <= (k) && (k) < (f)->dim.col)
+
+/******************************************************************************
+ * Definition of the functions.
+ *****************************************************************************/
+
+s_frame* frame_create(const s_point *dim);
+
+void frame_free(s_frame *frame);
+
+void frame_erase(s_frame *frame, const int row, const int col, const int rows, const int cols);
+
+void frame_shift(s_frame *frame, s_target *target, const int rows, const int cols);
+
+int frame_flush(s_frame *frame, s_target *target);
+
+#endif /* INC_HG_FRAME_H_ */
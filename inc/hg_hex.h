@@ -27,11 +27,20 @@
 
 #include "hg_common.h"
 #include "hg_color.h"
+#include "hg_frame.h"
 
 #include "ncurses.h"
 
 #define HEX_SIZE 4
 
+//
+// The distance of the upper left corners of two adjacent hex fields in the
+// same column (rows) and in the same row (columns), in characters.
+//
+#define HEX_STEP_ROW 4
+
+#define HEX_STEP_COL 3
+
 /******************************************************************************
  * The struct for a hex point, which consists of a (foreground) character and a
  * foreground and background color.
@@ -57,6 +66,21 @@ typedef struct {
 
 } s_hex_field;
 
+/******************************************************************************
+ * The hex image is a composed hex field, with the characters and the color
+ * pairs that are printed. Cells that show the empty space have the character
+ * HEX_CHR_SPACE. They are replaced with a star or a blank, when the image is
+ * printed, so the image does not depend on the stars of a hex field.
+ *****************************************************************************/
+
+#define HEX_CHR_SPACE L'\0'
+
+typedef struct {
+
+	s_cell cell[HEX_SIZE][HEX_SIZE];
+
+} s_hex_image;
+
 /******************************************************************************
  * The macro definitions.
  *****************************************************************************/
@@ -67,6 +91,12 @@ typedef struct {
 
 #define hex_point_set_undef(h) (h).chr = W_NULL; (h).fg = COLOR_UNDEF; (h).bg = COLOR_UNDEF
 
+//
+// The macro returns the bit of a point in a star mask, which has a bit for
+// each point of a hex field.
+//
+#define hex_star_bit(r,c) (1 << ((r) * HEX_SIZE + (c)))
+
 //
 // The macro definition to get the shading of the background color.
 //
@@ -80,7 +110,9 @@ void hex_get_hex_idx(const int win_row, const int win_col, const s_point *hex_ma
 
 void hex_field_set_corners(s_hex_field *hex_field);
 
-void hex_field_print(WINDOW *win, const s_point *pos_ul, const s_hex_field *hex_field_fg, const s_hex_field *hex_field_bg);
+void hex_image_compose(s_hex_image *hex_image, const s_hex_field *hex_field_fg, const s_hex_field *hex_field_bg);
+
+void hex_image_print(s_frame *frame, const s_point *pos_ul, const s_hex_image *hex_image, const unsigned short stars);
 
 void hex_field_set_bg(s_hex_field *hex_field, const short bg);
 
@@ -47,8 +47,6 @@ void s_marker_move_init();
 
 s_marker_move* s_marker_move_get(const e_dir dir);
 
-void s_marker_move_release();
-
 void s_marker_move_to_field(const s_marker_move *marker, const int color_idx, s_hex_field *hex_field, const bool highlight);
 
 #endif /* INC_HG_MARKER_MOVE_H_ */
@@ -0,0 +1,99 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_HG_METRICS_H_
+#define INC_HG_METRICS_H_
+
+#include "hg_common.h"
+#include "hg_frame.h"
+
+/******************************************************************************
+ * The metrics of a frame, which is the processing of an input including the
+ * rendering and the output to the terminal.
+ *****************************************************************************/
+
+typedef struct {
+
+	//
+	// The time of the frame in seconds.
+	//
+	double time;
+
+	//
+	// The number of printed hex fields.
+	//
+	long hexes;
+
+	//
+	// The number of cells that were flushed to the render target.
+	//
+	long cells;
+
+	//
+	// The number of color pair lookups.
+	//
+	long cp_lookups;
+
+	//
+	// The number of hex images that were not cached.
+	//
+	long cache_misses;
+
+	//
+	// The number of bytes written to the terminal.
+	//
+	long bytes;
+
+} s_metrics;
+
+/******************************************************************************
+ * The metrics of the current frame. The counters are updated with the macro,
+ * which is cheap enough for the hot paths.
+ *****************************************************************************/
+
+extern s_metrics _metrics;
+
+#define metrics_add(f,n) (_metrics.f += (n))
+
+/******************************************************************************
+ * Definition of the functions.
+ *****************************************************************************/
+
+void metrics_count_fd(const int fd);
+
+void metrics_count_write(const int fd, const long result);
+
+void metrics_frame_start();
+
+void metrics_frame_end();
+
+const s_metrics* metrics_last();
+
+void metrics_print(s_frame *frame, const int row);
+
+void metrics_dump(const char *path);
+
+void metrics_free();
+
+#endif /* INC_HG_METRICS_H_ */
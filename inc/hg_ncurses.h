@@ -25,8 +25,12 @@
 #ifndef INC_HG_NCURSES_H_
 #define INC_HG_NCURSES_H_
 
+#include <ncurses.h>
+
 void ncur_init();
 
 void ncur_exit();
 
+void ncur_win_shift(WINDOW *win, const int rows, const int cols);
+
 #endif /* INC_HG_NCURSES_H_ */
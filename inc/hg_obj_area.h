@@ -64,22 +64,41 @@ struct s_object {
 		s_ship_inst *ship_inst;
 	};
 
-	s_object *neighbour[6];
-
 	s_marker *marker;
+
+	//
+	// The flag is set if the object changed and has to be printed again.
+	//
+	bool damaged;
 };
 
+/******************************************************************************
+ * The object area is split into tiles of OBJ_AREA_TILE_SIZE x
+ * OBJ_AREA_TILE_SIZE objects. A tile is allocated, when one of its objects is
+ * accessed the first time. Empty tiles outside the viewport are evicted, if
+ * more than OBJ_AREA_TILES_MAX tiles are loaded.
+ *****************************************************************************/
+
+#define OBJ_AREA_TILE_SIZE 16
+
+#define OBJ_AREA_TILES_MAX 64
+
 /******************************************************************************
  * Macros to access the object area.
  *****************************************************************************/
 
-extern s_object **_obj_area;
+#define s_object_set_ship_at(r,c,i) obj_area_get(r,c)->obj = OBJ_SHIP; obj_area_get(r,c)->ship_inst = (i)
 
-#define s_object_set_ship_at(r,c,i) _obj_area[r][c].obj = OBJ_SHIP; _obj_area[r][c].ship_inst = (i)
+/******************************************************************************
+ * The macro is called with a current position and a direction. It updates the
+ * target point to the adjacent field in the given direction. The offset is
+ * taken from a table, which is indexed by the parity of the column and the
+ * direction, so there is no branch on the direction.
+ *****************************************************************************/
 
-#define obj_area_get(r,c) &_obj_area[r][c]
+extern const s_point _obj_area_adj[2][DIR_NUM];
 
-#define obj_area_add_marker(r,c,m) _obj_area[r][c].marker = (m)
+#define obj_area_goto(f,d,t) ((t)->row = (f)->row + _obj_area_adj[(f)->col & 1][d].row, (t)->col = (f)->col + _obj_area_adj[(f)->col & 1][d].col)
 
 /******************************************************************************
  * The definitions of the functions.
@@ -89,7 +108,23 @@ void obj_area_init(const s_point *dim_hex);
 
 void obj_area_free();
 
-void obj_area_goto(const s_point *from, const e_dir dir, s_point *to);
+s_object* obj_area_get(const int row, const int col);
+
+s_object* obj_area_peek(const int row, const int col);
+
+bool obj_area_adjacent(const s_point *from, const e_dir dir, s_point *to);
+
+s_object* obj_area_neighbour(const s_object *obj, const e_dir dir);
+
+void obj_area_evict(const s_point *pos, const s_point *dim);
+
+int obj_area_tiles_num();
+
+void obj_area_add_marker(s_object *obj, s_marker *marker);
+
+void obj_area_rm_markers();
+
+void obj_area_goto_all(const s_point *from, s_point to[DIR_NUM]);
 
 bool obj_area_can_mv_to(const s_object *obj_to);
 
@@ -99,4 +134,12 @@ s_object* obj_area_set_mv_marker(s_object *obj_from, const e_dir);
 
 s_object* obj_area_set_mv_marker_path(s_object *obj_from, const char *mv_path);
 
+void obj_area_set_mv_markers(s_object *obj_from);
+
+void obj_area_damage(s_object *obj);
+
+s_object* obj_area_damage_next();
+
+void obj_area_damage_reset();
+
 #endif /* INC_HG_OBJ_AREA_H_ */
@@ -0,0 +1,124 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_HG_POOL_H_
+#define INC_HG_POOL_H_
+
+#include "hg_common.h"
+
+/******************************************************************************
+ * The pool is an allocator for elements of a fixed size. The elements are
+ * stored in chunks, which are allocated on demand and never moved, so the
+ * pointers to the elements are stable. Released elements are added to a free
+ * list and reused, so after the pool has grown to its working size, no more
+ * memory is allocated.
+ *
+ * Each element has a generation, which is incremented when the element is
+ * allocated and when it is released (odd generations are in use). A handle
+ * is the index and the generation of an element, so a handle to a released
+ * or reused element is detected as stale.
+ *****************************************************************************/
+
+typedef struct s_pool_hdl {
+
+	int idx;
+
+	unsigned int gen;
+
+} s_pool_hdl;
+
+typedef struct s_pool {
+
+	//
+	// The name of the pool for the error messages.
+	//
+	const char *name;
+
+	//
+	// The size of an element and the size of a slot, which is the element
+	// with the header.
+	//
+	size_t elem_size;
+
+	size_t slot_size;
+
+	//
+	// The chunks with the slots.
+	//
+	char **chunks;
+
+	int chunk_slots;
+
+	int chunk_num;
+
+	int chunk_max;
+
+	//
+	// The number of slots of the chunks, that were used at least once.
+	//
+	int slot_num;
+
+	//
+	// The index of the first slot of the free list or -1.
+	//
+	int free;
+
+	//
+	// The number of elements in use.
+	//
+	int used;
+
+} s_pool;
+
+/******************************************************************************
+ * The definitions of the functions.
+ *****************************************************************************/
+
+void pool_init(s_pool *pool, const char *name, const size_t elem_size, const int chunk_slots);
+
+void pool_free(s_pool *pool);
+
+void* pool_alloc(s_pool *pool);
+
+void pool_release(s_pool *pool, void *elem);
+
+void pool_release_all(s_pool *pool);
+
+s_pool_hdl pool_hdl(const s_pool *pool, const void *elem);
+
+void* pool_get(const s_pool *pool, const s_pool_hdl hdl);
+
+bool pool_is_live(const s_pool *pool, const void *elem);
+
+//
+// The macro terminates the program, if an element is not in use. It is used
+// to detect stale pointers and is only active in the DEBUG mode.
+//
+#ifdef DEBUG
+#define pool_check(p,e) if (!pool_is_live((p), (e))) { log_exit("Stale element of pool: %s", (p)->name); }
+#else
+#define pool_check(p,e)
+#endif
+
+#endif /* INC_HG_POOL_H_ */
@@ -0,0 +1,93 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_HG_REACH_H_
+#define INC_HG_REACH_H_
+
+#include "hg_common.h"
+#include "hg_obj_area.h"
+
+/******************************************************************************
+ * The reachability computes all states (hex field and direction) that a ship
+ * can reach with its movement points, together with the cheapest path to each
+ * state. A step is a turn (left, center or right) followed by a move forward,
+ * which is the same as a character of a path string. The ship cannot enter
+ * hex fields with objects or leave the object area.
+ *
+ * Each step has to cost at least 1 movement point (s_ship_move.cost), so a
+ * ship with n points moves at most n hex fields. reach_compute() terminates
+ * the program for smaller costs or negative points.
+ *****************************************************************************/
+
+typedef struct {
+
+	//
+	// The position and direction of the state.
+	//
+	s_point pos;
+
+	e_dir dir;
+
+	//
+	// The cost of the cheapest path to the state.
+	//
+	short cost;
+
+	//
+	// The turn of the last step of the cheapest path, which is an index of
+	// s_ship_move.cost.
+	//
+	short turn;
+
+	//
+	// The index of the previous state on the cheapest path or -1 for the
+	// start state.
+	//
+	int parent;
+
+} s_reach_state;
+
+typedef struct {
+
+	//
+	// The reachable states in the order of increasing costs. The first state
+	// is the start state.
+	//
+	s_reach_state *states;
+
+	int num;
+
+} s_reach;
+
+/******************************************************************************
+ * The definitions of the functions.
+ *****************************************************************************/
+
+void reach_compute(s_arena *arena, const s_ship_move *move, const s_point *start, const e_dir dir, s_reach *reach);
+
+void reach_ship(s_arena *arena, const s_object *obj, s_reach *reach);
+
+int reach_path(const s_reach *reach, const int idx, char *path, const int size);
+
+#endif /* INC_HG_REACH_H_ */
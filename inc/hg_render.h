@@ -0,0 +1,50 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_HG_RENDER_H_
+#define INC_HG_RENDER_H_
+
+#include "hg_common.h"
+#include "hg_frame.h"
+#include "hg_target.h"
+#include "hg_obj_area.h"
+#include "hg_viewport.h"
+
+/******************************************************************************
+ * The functions print the objects of the viewport to a frame. They do not
+ * depend on a terminal, the frame is flushed to a render target by the
+ * caller.
+ *****************************************************************************/
+
+void render_cache_reset();
+
+void render_object(s_frame *frame, const s_viewport *viewport, const s_object *obj, const bool highlight);
+
+void render_objects(s_frame *frame, const s_viewport *viewport, const s_object *cursor);
+
+void render_objects_scroll(s_frame *frame, s_target *target, const s_viewport *viewport, const s_point *pos_old, const s_object *cursor);
+
+void render_damaged(s_frame *frame, const s_viewport *viewport, const s_object *cursor);
+
+#endif /* INC_HG_RENDER_H_ */
@@ -32,12 +32,62 @@
  * The enum value is the id of the ship type.
  *****************************************************************************/
 
+#define SHIP_TYPE_NUM 1
+
 typedef enum {
 
 	SHIP_TYPE_NORMAL
 
 } e_ship_type;
 
+/******************************************************************************
+ * The paths of a ship type are compiled to a trie of relative turns. Paths
+ * with a common prefix share the nodes of the prefix, so the prefix is walked
+ * only once. Node 0 is the root, which is never a child, so a child index of
+ * 0 means that there is no child.
+ *****************************************************************************/
+
+#define PATH_NODES_MAX 32
+
+//
+// The turns of a step: left, center, right.
+//
+#define PATH_TURN_NUM 3
+
+typedef struct {
+
+	//
+	// The index of the child node for each turn.
+	//
+	short child[PATH_TURN_NUM];
+
+	//
+	// The absolute direction of the step to this node, for each starting
+	// direction of the ship.
+	//
+	e_dir dir[DIR_NUM];
+
+	//
+	// True if a path ends at this node.
+	//
+	bool end;
+
+} s_path_node;
+
+/******************************************************************************
+ * The movement of a ship type for the reachability. A ship has a number of
+ * movement points per turn and each step costs points depending on the turn
+ * (left, center, right) before the step.
+ *****************************************************************************/
+
+typedef struct {
+
+	short points;
+
+	short cost[PATH_TURN_NUM];
+
+} s_ship_move;
+
 /******************************************************************************
  * The definition of a ship type. The different types differ in the colors and
  * the allowed movements, which are represented by paths.
@@ -45,6 +95,11 @@ typedef enum {
 
 typedef struct {
 
+	//
+	// The id of the ship type.
+	//
+	e_ship_type type;
+
 	//
 	// The color definitions of the ship type.
 	//
@@ -55,6 +110,24 @@ typedef struct {
 	//
 	char **paths;
 
+	//
+	// The trie with the compiled paths.
+	//
+	s_path_node path_trie[PATH_NODES_MAX];
+
+	int path_nodes;
+
+	//
+	// The movement points and costs of the ship type.
+	//
+	s_ship_move move;
+
+	//
+	// The ship hex fields for each direction, with the colors of the ship
+	// type. The sprites are composed once, when the ship type is initialized.
+	//
+	s_hex_field sprite[DIR_NUM];
+
 } s_ship_type;
 
 /******************************************************************************
@@ -75,6 +148,16 @@ typedef struct {
 
 } s_ship_inst;
 
+/******************************************************************************
+ * Definition of the macros.
+ *****************************************************************************/
+
+//
+// The macro returns the ship hex field (sprite) for a ship type and a
+// direction.
+//
+#define ship_get_hex_field(t,d) ((const s_hex_field*) &(t)->sprite[d])
+
 /******************************************************************************
  * Definition of the functions.
  *****************************************************************************/
@@ -83,8 +166,10 @@ void ship_field_init();
 
 void ship_field_free();
 
-void ship_get_hex_field(const s_ship_type *ship_type, const e_dir dir, s_hex_field *ship_field);
-
 s_ship_inst* s_ship_inst_create(const e_ship_type ship_type, const e_dir dir);
 
+void s_ship_inst_release(s_ship_inst *ship_inst);
+
+void s_ship_inst_check(const s_ship_inst *ship_inst);
+
 #endif /* INC_HG_SHIP_H_ */
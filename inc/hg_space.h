@@ -40,8 +40,14 @@
 
 void space_init(s_point *dim_hex);
 
+void space_init_seed(s_point *dim_hex, const unsigned int seed);
+
 void space_free();
 
-void space_get_hex_field(const s_point *hex_idx, const int color_idx, const bool highlight, s_hex_field *space_field);
+void space_get_hex_field(const int color_idx, const bool highlight, s_hex_field *space_field);
+
+unsigned short space_get_stars(const s_point *hex_idx);
+
+unsigned short space_stars_hash(const unsigned int seed, const int hex_row, const int hex_col);
 
 #endif /* INC_HG_SPACE_H_ */
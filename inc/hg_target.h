@@ -0,0 +1,114 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_HG_TARGET_H_
+#define INC_HG_TARGET_H_
+
+#include <ncurses.h>
+
+#include "hg_common.h"
+
+/******************************************************************************
+ * A cell is a character with a color pair. It is the unit that is written to
+ * a render target.
+ *****************************************************************************/
+
+typedef struct {
+
+	wchar_t chr;
+
+	short cp;
+
+} s_cell;
+
+/******************************************************************************
+ * The render target is the destination of the frame. The content is written
+ * with runs of cells and can be shifted. There are two backends:
+ *
+ * - ncurses: the cells are written to a window.
+ * - memory: the cells are written to a grid of cells. This does not require a
+ *   terminal, so it can be used for tests and benchmarks.
+ *****************************************************************************/
+
+typedef struct s_target s_target;
+
+struct s_target {
+
+	s_point dim;
+
+	//
+	// The function writes a run of cells to a row, starting at a column.
+	//
+	void (*write)(s_target *target, const int row, const int col, const s_cell *cells, const int num);
+
+	//
+	// The function shifts the content. Positive values shift down / right,
+	// negative values shift up / left.
+	//
+	void (*shift)(s_target *target, const int rows, const int cols);
+
+	//
+	// The window of the ncurses backend.
+	//
+	WINDOW *win;
+
+	//
+	// The cells of the memory backend.
+	//
+	s_cell *cells;
+};
+
+/******************************************************************************
+ * Definition of the macros.
+ *****************************************************************************/
+
+#define CELL_BLANK_CHR L' '
+
+#define CELL_BLANK_CP 0
+
+#define cell_set_blank(c) (c)->chr = CELL_BLANK_CHR; (c)->cp = CELL_BLANK_CP
+
+#define target_write(t,r,k,c,n) (t)->write((t),(r),(k),(c),(n))
+
+#define target_shift(t,r,k) (t)->shift((t),(r),(k))
+
+#define target_mem_cell(t,r,k) (&(t)->cells[(r) * (t)->dim.col + (k)])
+
+/******************************************************************************
+ * Definition of the functions.
+ *****************************************************************************/
+
+void target_cells_blank(s_cell *cells, const int num);
+
+void target_cells_shift(const s_point *dim, s_cell *cells, const int rows, const int cols);
+
+s_target* target_ncur_create(WINDOW *win);
+
+s_target* target_mem_create(const s_point *dim);
+
+void target_mem_line(const s_target *target, const int row, wchar_t *line);
+
+void target_free(s_target *target);
+
+#endif /* INC_HG_TARGET_H_ */
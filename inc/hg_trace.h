@@ -0,0 +1,102 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef INC_HG_TRACE_H_
+#define INC_HG_TRACE_H_
+
+#include "hg_common.h"
+
+/******************************************************************************
+ * The levels and the categories of the trace events.
+ *****************************************************************************/
+
+typedef enum {
+
+	TRACE_DEBUG, TRACE_INFO, TRACE_WARN
+
+} e_trace_level;
+
+typedef enum {
+
+	TRACE_RENDER, TRACE_INPUT, TRACE_COLOR, TRACE_AREA
+
+} e_trace_category;
+
+#define trace_category_bit(c) (1 << (c))
+
+#define TRACE_CATEGORY_ALL 0xF
+
+/******************************************************************************
+ * The trace macros record an event in a ring buffer, if the TRACE flag is
+ * defined. Otherwise they are compiled out. The arguments are stored as long
+ * values and the format string is applied when the ring buffer is dumped, so
+ * the format has to use %ld and has to be a string literal.
+ *
+ * Example: trace_event(TRACE_DEBUG, TRACE_RENDER, "cells: %ld", num);
+ *****************************************************************************/
+
+#define TRACE_ARGS 4
+
+//
+// The number of events in the ring buffer, which has to be a power of 2.
+//
+#define TRACE_SIZE 4096
+
+#ifdef TRACE
+
+#define trace_enabled(l,c) ((l) >= _trace_level && (trace_category_bit(c) & _trace_categories))
+
+#define trace_event(l,c,fmt,...) (trace_enabled(l,c) ? trace_add((l), (c), __func__, (fmt), (long[TRACE_ARGS]) { __VA_ARGS__ }) : (void) 0)
+#define trace_event_str(l,c,fmt) (trace_enabled(l,c) ? trace_add((l), (c), __func__, (fmt), NULL) : (void) 0)
+
+#define TRACE_USED
+
+#else
+
+#define trace_event(l,c,fmt,...)
+#define trace_event_str(l,c,fmt)
+
+#define TRACE_USED __attribute__((unused))
+
+#endif
+
+/******************************************************************************
+ * The filter for the events, which can be changed at runtime.
+ *****************************************************************************/
+
+extern e_trace_level _trace_level;
+
+extern int _trace_categories;
+
+/******************************************************************************
+ * Definition of the functions.
+ *****************************************************************************/
+
+void trace_add(const e_trace_level level, const e_trace_category category, const char *func, const char *fmt, const long *args);
+
+int trace_dump(FILE *stream);
+
+void trace_reset();
+
+#endif /* INC_HG_TRACE_H_ */
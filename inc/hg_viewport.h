@@ -65,6 +65,8 @@ bool s_viewport_inside_viewport(const s_viewport *viewport, const s_point *idx);
 
 bool s_viewport_update(s_viewport *viewport, const s_point *idx);
 
+bool s_viewport_mv_diff(s_viewport *viewport, const s_point *diff);
+
 void s_viewport_get_ul(const s_viewport *viewport, const s_point *idx_abs, s_point *pos_ul);
 
 #endif /* INC_HG_VIEWPORT_H_ */
@@ -0,0 +1,221 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "hg_common.h"
+#include "hg_color_pair.h"
+#include "bm_utils.h"
+
+/******************************************************************************
+ * The benchmark compares the lookup table of hg_color_pair.c with the former
+ * implementation, which was a sorted array with qsort() and bsearch(). The
+ * former implementation is copied here (without init_pair()).
+ *****************************************************************************/
+
+typedef struct {
+
+	short fg;
+	short bg;
+	short cp;
+
+} s_color_pair;
+
+#define BM_CP_MAX 64
+
+//
+// The first color pair id of the benchmark. Other benchmarks may have
+// registered color pairs before, so the value is set at the start.
+//
+static short _bm_cp_start;
+
+static size_t _bm_cp_num = 0;
+
+static s_color_pair _bm_cp_array[BM_CP_MAX];
+
+static bool _bm_is_sorted = false;
+
+static int bm_color_pair_comp(const void *ptr1, const void *ptr2) {
+
+	const s_color_pair *cp1 = (s_color_pair*) ptr1;
+	const s_color_pair *cp2 = (s_color_pair*) ptr2;
+
+	if (cp1->fg != cp2->fg) {
+		return cp1->fg - cp2->fg;
+	}
+
+	return cp1->bg - cp2->bg;
+}
+
+static short bm_sorted_add(const short fg, const short bg) {
+
+	if (_bm_cp_num == BM_CP_MAX) {
+		log_exit_str("Too many pairs!");
+	}
+
+	s_color_pair *cp_ptr = &_bm_cp_array[_bm_cp_num];
+
+	cp_ptr->fg = fg;
+	cp_ptr->bg = bg;
+	cp_ptr->cp = _bm_cp_num + _bm_cp_start;
+
+	_bm_cp_num++;
+	_bm_is_sorted = false;
+
+	return cp_ptr->cp;
+}
+
+static short bm_sorted_get(const short fg, const short bg) {
+
+	if (!_bm_is_sorted) {
+		qsort(_bm_cp_array, _bm_cp_num, sizeof(s_color_pair), bm_color_pair_comp);
+		_bm_is_sorted = true;
+	}
+
+	s_color_pair key = { .fg = fg, .bg = bg };
+
+	const s_color_pair *result = bsearch(&key, _bm_cp_array, _bm_cp_num, sizeof(s_color_pair), bm_color_pair_comp);
+
+	if (result != NULL) {
+		return result->cp;
+	}
+
+	return bm_sorted_add(fg, bg);
+}
+
+/******************************************************************************
+ * The number of color pairs and the number of lookups of the benchmark. The
+ * benchmark uses the 8 predefined colors, which gives 64 combinations.
+ *****************************************************************************/
+
+#define BM_PAIRS 32
+
+#define BM_LOOKUPS 10000000L
+
+#define bm_fg(i) ((i) % 8)
+
+#define bm_bg(i) ((i) / 8)
+
+/******************************************************************************
+ * The function measures lookups of registered color pairs. The checksum
+ * prevents the compiler from removing the lookups.
+ *****************************************************************************/
+
+static void bm_color_pair_lookup() {
+	double start;
+	long sum_sorted = 0, sum_table = 0;
+
+	for (int i = 0; i < BM_PAIRS; i++) {
+		bm_sorted_add(bm_fg(i), bm_bg(i));
+		cp_color_pair_add(bm_fg(i), bm_bg(i));
+	}
+
+	start = bm_time();
+
+	for (long i = 0; i < BM_LOOKUPS; i++) {
+		sum_sorted += bm_sorted_get(bm_fg(i % BM_PAIRS), bm_bg(i % BM_PAIRS));
+	}
+
+	bm_report("color pair lookup: sorted array", BM_LOOKUPS, start);
+
+	start = bm_time();
+
+	for (long i = 0; i < BM_LOOKUPS; i++) {
+		sum_table += cp_color_pair_get(bm_fg(i % BM_PAIRS), bm_bg(i % BM_PAIRS));
+	}
+
+	bm_report("color pair lookup: table", BM_LOOKUPS, start);
+
+	if (sum_sorted != sum_table) {
+		log_exit("Checksums differ: %ld %ld", sum_sorted, sum_table);
+	}
+}
+
+/******************************************************************************
+ * The function adds a new color pair after every few lookups, which causes a
+ * sort of the array for the former implementation. The color pairs of the
+ * lookup benchmark are registered already, so the new pairs follow them.
+ *****************************************************************************/
+
+#define BM_ADD_PAIRS 8
+
+#define BM_ADD_LOOKUPS 1000
+
+static void bm_color_pair_add() {
+	double start;
+	long sum = 0;
+
+	start = bm_time();
+
+	for (int i = 0; i < BM_ADD_PAIRS; i++) {
+		sum += bm_sorted_get(bm_fg(BM_PAIRS + i), bm_bg(BM_PAIRS + i));
+
+		for (long j = 0; j < BM_ADD_LOOKUPS; j++) {
+			sum += bm_sorted_get(bm_fg(j % BM_PAIRS), bm_bg(j % BM_PAIRS));
+		}
+	}
+
+	bm_report("color pair add + lookup: sorted array", BM_ADD_PAIRS * (BM_ADD_LOOKUPS + 1), start);
+
+	start = bm_time();
+
+	for (int i = 0; i < BM_ADD_PAIRS; i++) {
+		sum -= cp_color_pair_get(bm_fg(BM_PAIRS + i), bm_bg(BM_PAIRS + i));
+
+		for (long j = 0; j < BM_ADD_LOOKUPS; j++) {
+			sum -= cp_color_pair_get(bm_fg(j % BM_PAIRS), bm_bg(j % BM_PAIRS));
+		}
+	}
+
+	bm_report("color pair add + lookup: table", BM_ADD_PAIRS * (BM_ADD_LOOKUPS + 1), start);
+
+	if (sum != 0) {
+		log_exit("Checksums differ: %ld", sum);
+	}
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the benchmarks. The color
+ * pairs are headless, so ncurses is not initialized.
+ *****************************************************************************/
+
+void bm_color_pair_exec() {
+
+	col_set_headless(true);
+
+	//
+	// The color pairs are registered in the same order, so the ids of both
+	// implementations are the same.
+	//
+	_bm_cp_start = cp_color_pair_add(bm_fg(0), bm_bg(0));
+
+	bm_color_pair_lookup();
+
+	bm_color_pair_add();
+
+	//
+	// The color pairs are created again by the next benchmark.
+	//
+	cp_color_pair_reset();
+
+	col_set_headless(false);
+}
@@ -0,0 +1,142 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "hg_common.h"
+#include "hg_obj_area.h"
+#include "bm_utils.h"
+
+/******************************************************************************
+ * The benchmark compares the table driven obj_area_goto() and the batched
+ * obj_area_goto_all() with the former implementation, which was a switch on
+ * the direction. The former implementation is copied here. Each benchmark
+ * computes the 6 neighbours of each hex field of a BM_DIM x BM_DIM area.
+ *****************************************************************************/
+
+#define BM_DIM 1000
+
+static void bm_goto_switch(const s_point *from, const e_dir dir, s_point *to) {
+
+	switch (dir) {
+
+	case DIR_NN:
+		to->row = from->row - 1;
+		to->col = from->col;
+		break;
+
+	case DIR_NE:
+		to->row = from->row % 2 == 0 ? from->row - 1 + from->col % 2 : from->row - 1 + from->col % 2;
+		to->col = from->col + 1;
+		break;
+
+	case DIR_SE:
+		to->row = from->row % 2 == 0 ? from->row + from->col % 2 : from->row + from->col % 2;
+		to->col = from->col + 1;
+		break;
+
+	case DIR_SS:
+		to->row = from->row + 1;
+		to->col = from->col;
+		break;
+
+	case DIR_SW:
+		to->row = from->row % 2 == 0 ? from->row + from->col % 2 : from->row + from->col % 2;
+		to->col = from->col - 1;
+		break;
+
+	case DIR_NW:
+		to->row = from->row % 2 == 0 ? from->row - 1 + from->col % 2 : from->row - 1 + from->col % 2;
+		to->col = from->col - 1;
+		break;
+
+	default:
+		log_exit("Unknown direction: %d", dir)
+		;
+	}
+}
+
+/******************************************************************************
+ * The function measures the computation of the neighbours. The checksum
+ * prevents the compiler from removing the computations.
+ *****************************************************************************/
+
+static void bm_obj_area_goto() {
+	double start;
+	long sum_switch = 0, sum_table = 0, sum_all = 0;
+	s_point from, to;
+	s_point to_all[DIR_NUM];
+
+	start = bm_time();
+
+	for (from.row = 0; from.row < BM_DIM; from.row++) {
+		for (from.col = 0; from.col < BM_DIM; from.col++) {
+			for (e_dir dir = 0; dir < DIR_NUM; dir++) {
+				bm_goto_switch(&from, dir, &to);
+				sum_switch += to.row * BM_DIM + to.col;
+			}
+		}
+	}
+
+	bm_report("obj area goto: switch", (long) BM_DIM * BM_DIM * DIR_NUM, start);
+
+	start = bm_time();
+
+	for (from.row = 0; from.row < BM_DIM; from.row++) {
+		for (from.col = 0; from.col < BM_DIM; from.col++) {
+			for (e_dir dir = 0; dir < DIR_NUM; dir++) {
+				obj_area_goto(&from, dir, &to);
+				sum_table += to.row * BM_DIM + to.col;
+			}
+		}
+	}
+
+	bm_report("obj area goto: table", (long) BM_DIM * BM_DIM * DIR_NUM, start);
+
+	start = bm_time();
+
+	for (from.row = 0; from.row < BM_DIM; from.row++) {
+		for (from.col = 0; from.col < BM_DIM; from.col++) {
+
+			obj_area_goto_all(&from, to_all);
+
+			for (e_dir dir = 0; dir < DIR_NUM; dir++) {
+				sum_all += to_all[dir].row * BM_DIM + to_all[dir].col;
+			}
+		}
+	}
+
+	bm_report("obj area goto: all", (long) BM_DIM * BM_DIM * DIR_NUM, start);
+
+	if (sum_switch != sum_table || sum_switch != sum_all) {
+		log_exit("Checksums differ: %ld %ld %ld", sum_switch, sum_table, sum_all);
+	}
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the benchmarks.
+ *****************************************************************************/
+
+void bm_obj_area_exec() {
+
+	bm_obj_area_goto();
+}
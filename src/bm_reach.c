@@ -0,0 +1,85 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "hg_common.h"
+#include "hg_reach.h"
+#include "bm_utils.h"
+
+/******************************************************************************
+ * The benchmark computes the reachable states of a ship in the middle of a
+ * BM_DIM x BM_DIM object area, for different movement points. Each operation
+ * is a computation of all reachable states. The arena is reset after each
+ * computation, like at the end of a turn.
+ *****************************************************************************/
+
+#define BM_DIM 1000
+
+#define BM_RUNS 100
+
+static void bm_reach_points(const int points) {
+	const s_point start = { .row = BM_DIM / 2, .col = BM_DIM / 2 };
+	const s_ship_move move = { .points = points, .cost = { 2, 1, 2 } };
+	char name[64];
+	s_reach reach;
+	long sum = 0;
+
+	snprintf(name, sizeof(name), "reach: points %d", points);
+
+	const double start_time = bm_time();
+
+	for (int i = 0; i < BM_RUNS; i++) {
+		reach_compute(&_arena_turn, &move, &start, i % DIR_NUM, &reach);
+		sum += reach.num;
+		arena_reset(&_arena_turn);
+	}
+
+	bm_report(name, BM_RUNS, start_time);
+
+	//
+	// The ship can at least move forward.
+	//
+	if (sum < 2 * BM_RUNS) {
+		log_exit("No states reachable: %ld", sum);
+	}
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the benchmarks.
+ *****************************************************************************/
+
+void bm_reach_exec() {
+	const s_point dim = { .row = BM_DIM, .col = BM_DIM };
+
+	obj_area_init(&dim);
+
+	bm_reach_points(5);
+
+	bm_reach_points(10);
+
+	bm_reach_points(20);
+
+	obj_area_free();
+
+	arena_free(&_arena_turn);
+}
@@ -0,0 +1,169 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "hg_common.h"
+#include "hg_color.h"
+#include "hg_space.h"
+#include "hg_ship.h"
+#include "hg_marker.h"
+#include "hg_render.h"
+#include "bm_utils.h"
+
+/******************************************************************************
+ * The benchmark renders the whole board of the game (10 rows and 24 columns of
+ * hex fields) to a memory target, so no terminal is required. A frame is
+ * printing all objects to the frame and flushing the frame.
+ *****************************************************************************/
+
+#define BM_FRAMES 10000L
+
+static const s_viewport _bm_viewport = { .dim = { 10, 24 }, .pos = { 0, 0 }, .max = { 10, 24 } };
+
+/******************************************************************************
+ * The function renders frames, where nothing changed. The flush does not
+ * write any cells, so this is the cost of composing the frame.
+ *****************************************************************************/
+
+static void bm_render_unchanged(s_frame *frame, s_target *target) {
+	long cells = 0;
+
+	const s_object *cursor = obj_area_get(0, 0);
+
+	const double start = bm_time();
+
+	for (long i = 0; i < BM_FRAMES; i++) {
+		render_objects(frame, &_bm_viewport, cursor);
+		cells += frame_flush(frame, target);
+	}
+
+	bm_report("render: full board unchanged", BM_FRAMES, start);
+
+	log_debug("Flushed cells: %ld", cells);
+}
+
+/******************************************************************************
+ * The function renders frames with a moving cursor, so the highlighting of
+ * two hex fields changes with each frame.
+ *****************************************************************************/
+
+static void bm_render_cursor(s_frame *frame, s_target *target) {
+	long cells = 0;
+
+	const double start = bm_time();
+
+	for (long i = 0; i < BM_FRAMES; i++) {
+		render_objects(frame, &_bm_viewport, obj_area_get(i % _bm_viewport.dim.row, i % _bm_viewport.dim.col));
+		cells += frame_flush(frame, target);
+	}
+
+	bm_report("render: full board moving cursor", BM_FRAMES, start);
+
+	log_debug("Flushed cells: %ld", cells);
+}
+
+/******************************************************************************
+ * The function renders frames to a blank target, so all cells are flushed.
+ * This is the cost of a redraw of the whole screen.
+ *****************************************************************************/
+
+static void bm_render_blank(s_frame *frame, s_target *target) {
+	long cells = 0;
+
+	const s_object *cursor = obj_area_get(0, 0);
+
+	const double start = bm_time();
+
+	for (long i = 0; i < BM_FRAMES; i++) {
+		target_cells_blank(frame->prev, frame->dim.row * frame->dim.col);
+
+		render_objects(frame, &_bm_viewport, cursor);
+		cells += frame_flush(frame, target);
+	}
+
+	bm_report("render: full board blank target", BM_FRAMES, start);
+
+	log_debug("Flushed cells: %ld", cells);
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the benchmarks. The rendering
+ * is headless, so ncurses is not initialized.
+ *****************************************************************************/
+
+void bm_render_exec() {
+
+	col_set_headless(true);
+
+	srand(1);
+
+	space_init((s_point*) &_bm_viewport.max);
+
+	obj_area_init(&_bm_viewport.max);
+
+	ship_field_init();
+
+	s_marker_init();
+
+	s_object_set_ship_at(3, 3, s_ship_inst_create(SHIP_TYPE_NORMAL, DIR_NE));
+	s_object_set_ship_at(3, 2, s_ship_inst_create(SHIP_TYPE_NORMAL, DIR_NN));
+
+	//
+	// The frame and the target cover the whole board.
+	//
+	const s_point dim = { .row = _bm_viewport.dim.row * HEX_STEP_ROW + HEX_SIZE / 2, .col = _bm_viewport.dim.col * HEX_STEP_COL + 1 };
+
+	s_target *target = target_mem_create(&dim);
+
+	s_frame *frame = frame_create(&dim);
+
+	bm_render_unchanged(frame, target);
+
+	bm_render_cursor(frame, target);
+
+	bm_render_blank(frame, target);
+
+	frame_free(frame);
+
+	target_free(target);
+
+	obj_area_free();
+
+	s_marker_free();
+
+	ship_field_free();
+
+	arena_free(&_arena_turn);
+
+	space_free();
+
+	//
+	// The colors are created again by the next initialization. The cached
+	// images contain the old color pairs.
+	//
+	col_color_reset();
+
+	render_cache_reset();
+
+	col_set_headless(false);
+}
@@ -0,0 +1,53 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <time.h>
+
+#include "hg_common.h"
+
+/******************************************************************************
+ * The function returns the time in seconds from a monotonic clock.
+ *****************************************************************************/
+
+double bm_time() {
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) {
+		log_exit_str("Unable to get time!");
+	}
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/******************************************************************************
+ * The function prints the result of a benchmark, which is the number of
+ * operations and the time since the start.
+ *****************************************************************************/
+
+void bm_report(const char *name, const long ops, const double start) {
+
+	const double sec = bm_time() - start;
+
+	printf("%-40s ops: %10ld time: %8.3f ms ns/op: %10.2f ops/s: %12.0f\n", name, ops, sec * 1e3, sec * 1e9 / ops, ops / sec);
+}
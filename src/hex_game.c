@@ -24,6 +24,8 @@
 
 #include <time.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 #include <locale.h>
 #include <ncurses.h>
 
@@ -38,6 +40,46 @@
 #include "hg_ship.h"
 #include "hg_obj_area.h"
 #include "hg_viewport.h"
+#include "hg_frame.h"
+#include "hg_target.h"
+#include "hg_render.h"
+#include "hg_metrics.h"
+#include "hg_trace.h"
+
+/******************************************************************************
+ * The frame is the off-screen buffer for the render target, which is stdscr.
+ * The objects are printed to the frame and the frame is flushed once per
+ * input.
+ *****************************************************************************/
+
+static s_target *_target = NULL;
+
+static s_frame *_frame = NULL;
+
+/******************************************************************************
+ * The metrics of the frames can be shown as an overlay in the last row of the
+ * screen (toggled with 'm') and written to a csv file on exit (option -m).
+ *****************************************************************************/
+
+static bool _metrics_overlay = false;
+
+static const char *_metrics_csv = NULL;
+
+/******************************************************************************
+ * If a seed is given (option -s), the stars of the space are computed from the
+ * seed, so the space can be reproduced.
+ *****************************************************************************/
+
+static bool _space_procedural = false;
+
+static unsigned int _space_seed;
+
+/******************************************************************************
+ * The dimension of the game in hex fields (options -r and -c). The object
+ * area is loaded in tiles on demand, so large games are possible.
+ *****************************************************************************/
+
+static s_point _game_dim = { .row = 10, .col = 24 };
 
 /******************************************************************************
  * The exit callback function resets the terminal and frees the memory. This is
@@ -49,10 +91,35 @@ static void hg_exit_callback() {
 
 	ncur_exit();
 
+	//
+	// The trace events are dumped after ncurses is finished.
+	//
+	trace_dump(stderr);
+
+	if (_metrics_csv != NULL) {
+		metrics_dump(_metrics_csv);
+	}
+
+	metrics_free();
+
+	if (_frame != NULL) {
+		frame_free(_frame);
+	}
+
+	if (_target != NULL) {
+		target_free(_target);
+	}
+
 	space_free();
 
 	obj_area_free();
 
+	s_marker_free();
+
+	ship_field_free();
+
+	arena_free(&_arena_turn);
+
 	log_debug_str("Exit callback finished!");
 }
 
@@ -66,6 +133,14 @@ static void hg_init() {
 
 	ncur_init();
 
+#ifdef METRICS_BYTES
+
+	//
+	// The output to the terminal is counted by the metrics.
+	//
+	metrics_count_fd(STDOUT_FILENO);
+#endif
+
 	//
 	// Register exit callback.
 	//
@@ -81,104 +156,39 @@ static void hg_init() {
 	srand((unsigned) time(&t));
 }
 
-/******************************************************************************
- *
- *****************************************************************************/
-
-static void print_object(s_viewport *viewport, s_object *obj, const bool highlight) {
-	s_hex_field hf_tmp_bg, hf_tmp_fg;
-
-	s_point pos_ul;
-	s_viewport_get_ul(viewport, &obj->pos, &pos_ul);
-
-	//
-	// Get the index of the shading (0, 1, 2)
-	//
-	const int color_idx = hex_field_color_idx(obj->pos.row, obj->pos.col);
-
-	log_debug("pos: %d/%d color index: %d", obj->pos.row, obj->pos.col, color_idx);
-
-	switch (obj->obj) {
-
-	case OBJ_NONE:
-
-		log_debug("space: %d/%d", obj->pos.row, obj->pos.col);
-
-		space_get_hex_field(&obj->pos, color_idx, highlight, &hf_tmp_bg);
-
-		s_marker_add_to_field(obj->marker, color_idx, highlight, &hf_tmp_bg);
-
-		hex_field_print(stdscr, &pos_ul, NULL, &hf_tmp_bg);
-		break;
-
-	case OBJ_SHIP:
-
-		log_debug("ship: %d/%d", obj->pos.row, obj->pos.col);
-
-		space_get_hex_field(&obj->pos, color_idx, highlight, &hf_tmp_bg);
-
-		s_marker_add_to_field(obj->marker, color_idx, highlight, &hf_tmp_bg);
-
-		ship_get_hex_field(obj->ship_inst->ship_type, obj->ship_inst->dir, &hf_tmp_fg);
-
-		hex_field_print(stdscr, &pos_ul, &hf_tmp_fg, &hf_tmp_bg);
-		break;
-
-	default:
-		log_exit("Unknown object type: %d", obj->obj)
-		;
-	}
-}
+#ifdef METRICS_BYTES
 
 /******************************************************************************
- * The function prints the space hex fields of the game.
+ * The wrapper of write(), which is used by the linker for the executable
+ * (-Wl,--wrap=write). It counts the bytes written to the terminal for the
+ * metrics and calls write() of the C library.
  *****************************************************************************/
 
-static void print_objects(s_viewport *viewport) {
-	log_debug_str("Print objects");
-
-	s_object *obj;
-	s_point idx_rel, idx_abs;
-
-	if (wclear(stdscr) == ERR) {
-		log_exit_str("Unable to clear window.");
-	}
+ssize_t __real_write(int fd, const void *buf, size_t count);
 
-	for (idx_rel.row = 0; idx_rel.row < viewport->dim.row; idx_rel.row++) {
-		for (idx_rel.col = 0; idx_rel.col < viewport->dim.col; idx_rel.col++) {
+ssize_t __wrap_write(int fd, const void *buf, size_t count) {
 
-			s_viewport_get_abs(viewport, &idx_rel, &idx_abs);
+	const ssize_t result = __real_write(fd, buf, count);
 
-			obj = obj_area_get(idx_abs.row, idx_abs.col);
+	metrics_count_write(fd, result);
 
-			print_object(viewport, obj, false);
-		}
-	}
+	return result;
 }
+#endif
 
 /******************************************************************************
- *
+ * The function removes all markers from the object area. The objects with a
+ * marker are damaged. This is the end of a turn, so the turn arena is reset.
  *****************************************************************************/
 
-static void reset_marker(s_viewport *viewport) {
+static void reset_marker() {
 	log_debug_str("Resetting marker!");
 
-	s_point hex_idx;
-	s_object *object;
-
-	for (hex_idx.row = 0; hex_idx.row < viewport->max.row; hex_idx.row++) {
-		for (hex_idx.col = 0; hex_idx.col < viewport->max.col; hex_idx.col++) {
+	obj_area_rm_markers();
 
-			object = obj_area_get(hex_idx.row, hex_idx.col);
+	s_marker_release();
 
-			if (object->marker != NULL) {
-				object->marker = NULL;
-				print_object(viewport, object, false);
-			}
-		}
-	}
-
-	s_marker_reset();
+	arena_reset(&_arena_turn);
 }
 
 /******************************************************************************
@@ -190,14 +200,16 @@ static void set_ship(const int row, const int col, const e_ship_type ship_type,
 	s_ship_inst *ship_inst = s_ship_inst_create(ship_type, dir);
 
 	s_object_set_ship_at(row, col, ship_inst);
+
+	obj_area_damage(obj_area_get(row, col));
 }
 
 /******************************************************************************
- *
+ * The function sets the move markers for a ship. The objects with a marker are
+ * damaged.
  *****************************************************************************/
 
-static void set_marker(s_viewport *viewport, s_object *obj_from) {
-	s_object *obj_to;
+static void set_marker(s_object *obj_from) {
 
 	//
 	// Ensure that the object is a ship.
@@ -207,41 +219,30 @@ static void set_marker(s_viewport *viewport, s_object *obj_from) {
 	}
 
 	obj_area_set_mv_marker(obj_from, DIR_UNDEF);
-	print_object(viewport, obj_from, true);
 
 	//
-	// Set the marker along the paths.
+	// Set the marker along the paths of the ship type.
 	//
-	char **paths = obj_from->ship_inst->ship_type->paths;
-
-	for (int i = 0; paths[i] != NULL; i++) {
-
-		//
-		// Try to set the marker for the path. If it is not possible the
-		// function returns NULL.
-		//
-		obj_to = obj_area_set_mv_marker_path(obj_from, paths[i]);
-		if (obj_to != NULL) {
-			print_object(viewport, obj_to, false);
-		}
-	}
+	obj_area_set_mv_markers(obj_from);
 }
 
 /******************************************************************************
- *
+ * The function moves the cursor to a new position. If the new position is
+ * outside the viewport, the viewport is moved and printed. Otherwise the old
+ * and the new cursor position are damaged, because the highlighting changed.
  *****************************************************************************/
 
 static s_object* cursor_mv(s_viewport *viewport, s_object *obj_from, s_point *to) {
 
-	log_debug("Moving cursor from: %d/%d to: %d/%d viewport: %d/%d", obj_from->pos.row, obj_from->pos.col, to->row, to->col, viewport->pos.row, viewport->pos.col);
+	trace_event(TRACE_DEBUG, TRACE_INPUT, "Moving cursor from: %ld/%ld to: %ld/%ld", obj_from->pos.row, obj_from->pos.col, to->row, to->col);
 
 	if (!s_point_inside(&viewport->max, to)) {
-		log_debug("Target outside game: %d/%d", to->row, to->col);
+		trace_event(TRACE_DEBUG, TRACE_INPUT, "Target outside game: %ld/%ld", to->row, to->col);
 		return obj_from;
 	}
 
 	if (s_point_same(&obj_from->pos, to)) {
-		log_debug("Source and target are the same: %d/%d", to->row, to->col);
+		trace_event(TRACE_DEBUG, TRACE_INPUT, "Source and target are the same: %ld/%ld", to->row, to->col);
 		return obj_from;
 	}
 
@@ -249,27 +250,40 @@ static s_object* cursor_mv(s_viewport *viewport, s_object *obj_from, s_point *to
 
 	if (!s_viewport_inside_viewport(viewport, &obj_to->pos)) {
 
-		log_debug("Not inside viewport pos: %d/%d dim: %d/%d", viewport->pos.row, viewport->pos.col, viewport->dim.row, viewport->dim.col);
+		trace_event(TRACE_DEBUG, TRACE_INPUT, "Not inside viewport pos: %ld/%ld dim: %ld/%ld", viewport->pos.row, viewport->pos.col, viewport->dim.row, viewport->dim.col);
+
+		const s_point pos_old = viewport->pos;
 
+		//
+		// Scrolling would move the metrics overlay row into the board, so
+		// with the overlay all objects are printed.
+		//
 		if (s_viewport_update(viewport, &obj_to->pos)) {
-			print_objects(viewport);
+
+			if (_metrics_overlay) {
+				render_objects(_frame, viewport, obj_to);
+			} else {
+				render_objects_scroll(_frame, _target, viewport, &pos_old, obj_to);
+			}
 		}
 
 		if (!s_viewport_inside_viewport(viewport, &obj_to->pos)) {
 			log_exit_str("Outside");
 		}
 
-		print_object(viewport, obj_to, true);
+		//
+		// The old cursor position may still be visible.
+		//
+		obj_area_damage(obj_from);
+		obj_area_damage(obj_to);
 		return obj_to;
 	}
 
 	//
-	// Delete old and print the new
+	// The highlighting of both objects changed.
 	//
-	if (s_viewport_inside_viewport(viewport, &obj_from->pos)) {
-		print_object(viewport, obj_from, false);
-	}
-	print_object(viewport, obj_to, true);
+	obj_area_damage(obj_from);
+	obj_area_damage(obj_to);
 
 	return obj_to;
 }
@@ -290,21 +304,161 @@ static s_object* ship_move(s_viewport *viewport, s_object *obj_from, s_object *o
 
 	obj_area_mv_ship(obj_from, obj_to, obj_to->marker->marker_move->dir);
 
-	reset_marker(viewport);
-
-	print_object(viewport, obj_from, false);
-	print_object(viewport, obj_to, false);
+	reset_marker();
 
-	set_marker(viewport, obj_to);
+	set_marker(obj_to);
 
 	return obj_to;
 }
 
+/******************************************************************************
+ * The function moves the cursor to the hex field under the mouse. The hex
+ * index is relative to the viewport. Positions outside of the hex fields are
+ * ignored. The absolute hex index is stored as the target.
+ *****************************************************************************/
+
+static s_object* cursor_motion(s_viewport *viewport, s_object *obj_old, const s_point *motion_idx, s_point *hex_idx) {
+
+	if (motion_idx->row < 0) {
+		return obj_old;
+	}
+
+	//
+	// From the relative hex index to the absolute hex index.
+	//
+	s_viewport_get_abs(viewport, motion_idx, hex_idx);
+
+	return cursor_mv(viewport, obj_old, hex_idx);
+}
+
+/******************************************************************************
+ * The function processes a mouse click, which moves the ship to the hex field
+ * under the mouse. Positions outside of the hex fields are ignored.
+ *****************************************************************************/
+
+static s_object* hg_process_click(const MEVENT *event, s_viewport *viewport, s_object *obj_ship, s_point *hex_idx) {
+
+	//
+	// From event x/y to relative hex index inside the viewport
+	//
+	hex_get_hex_idx(event->y, event->x, &viewport->max, hex_idx);
+
+	if (hex_idx->row < 0) {
+		return obj_ship;
+	}
+
+	//
+	// From the relative hex index to the absolute hex index.
+	//
+	s_viewport_get_abs(viewport, hex_idx, hex_idx);
+
+	if (!s_point_inside(&viewport->max, hex_idx)) {
+		return obj_ship;
+	}
+
+	return ship_move(viewport, obj_ship, obj_area_get(hex_idx->row, hex_idx->col));
+}
+
+/******************************************************************************
+ * The function processes a key. The cursor, the ship and the target hex index
+ * are updated.
+ *****************************************************************************/
+
+static void hg_process_key(const int c, s_viewport *viewport, s_object **obj_old, s_object **obj_ship, s_point *hex_idx) {
+
+	switch (c) {
+
+	//
+	// Toggle the metrics overlay with 'm'. Removing the overlay requires
+	// printing all objects.
+	//
+	case 'm':
+		_metrics_overlay = !_metrics_overlay;
+
+		if (!_metrics_overlay) {
+			render_objects(_frame, viewport, *obj_old);
+		}
+		break;
+
+	case KEY_UP:
+		trace_event_str(TRACE_DEBUG, TRACE_INPUT, "arrow up");
+		s_point_set(hex_idx, (*obj_old)->pos.row - 1, (*obj_old)->pos.col)
+		;
+		*obj_old = cursor_mv(viewport, *obj_old, hex_idx);
+		break;
+
+	case KEY_DOWN:
+		trace_event_str(TRACE_DEBUG, TRACE_INPUT, "arrow down");
+		s_point_set(hex_idx, (*obj_old)->pos.row + 1, (*obj_old)->pos.col)
+		;
+		*obj_old = cursor_mv(viewport, *obj_old, hex_idx);
+		break;
+
+	case KEY_LEFT:
+		trace_event_str(TRACE_DEBUG, TRACE_INPUT, "arrow left");
+		s_point_set(hex_idx, (*obj_old)->pos.row, (*obj_old)->pos.col - 1)
+		;
+		*obj_old = cursor_mv(viewport, *obj_old, hex_idx);
+		break;
+
+	case KEY_RIGHT:
+		trace_event_str(TRACE_DEBUG, TRACE_INPUT, "arrow right");
+		s_point_set(hex_idx, (*obj_old)->pos.row, (*obj_old)->pos.col + 1)
+		;
+		*obj_old = cursor_mv(viewport, *obj_old, hex_idx);
+		break;
+
+	case 10:
+		trace_event_str(TRACE_DEBUG, TRACE_INPUT, "Enter");
+
+		if (s_point_inside(&viewport->max, hex_idx)) {
+			*obj_ship = ship_move(viewport, *obj_ship, obj_area_get(hex_idx->row, hex_idx->col));
+		}
+		break;
+	}
+}
+
+/******************************************************************************
+ * The function prints the usage and terminates the program.
+ *****************************************************************************/
+
+static void hg_usage(const char *name) {
+	fprintf(stderr, "Usage: %s [-m <metrics-csv-file>] [-s <seed>] [-r <rows>] [-c <cols>]\n", name);
+	exit(EXIT_FAILURE);
+}
+
+/******************************************************************************
+ * The function parses the command line arguments.
+ *****************************************************************************/
+
+static void hg_parse_args(const int argc, char *argv[]) {
+
+	for (int i = 1; i < argc; i++) {
+
+		if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+			_metrics_csv = argv[++i];
+
+		} else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+			_game_dim.row = atoi(argv[++i]);
+
+		} else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+			_game_dim.col = atoi(argv[++i]);
+
+		} else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+			_space_seed = (unsigned int) strtoul(argv[++i], NULL, 10);
+			_space_procedural = true;
+
+		} else {
+			hg_usage(argv[0]);
+		}
+	}
+}
+
 /******************************************************************************
  * Main
  *****************************************************************************/
 
-int main() {
+int main(const int argc, char *argv[]) {
 	s_object *obj_old;
 	s_object *obj_ship;
 
@@ -313,14 +467,31 @@ int main() {
 	s_viewport viewport;
 	viewport.dim.row = 5;
 	viewport.dim.col = 12;
-	viewport.max.row = 10;
-	viewport.max.col = 24;
 	viewport.pos.row = 0;
 	viewport.pos.col = 0;
 
+	hg_parse_args(argc, argv);
+
+	//
+	// The game has to be at least as large as the viewport.
+	//
+	if (_game_dim.row < viewport.dim.row || _game_dim.col < viewport.dim.col) {
+		hg_usage(argv[0]);
+	}
+
+	viewport.max = _game_dim;
+
 	hg_init();
 
-	space_init(&viewport.max);
+	_target = target_ncur_create(stdscr);
+
+	_frame = frame_create(&_target->dim);
+
+	if (_space_procedural) {
+		space_init_seed(&viewport.max, _space_seed);
+	} else {
+		space_init(&viewport.max);
+	}
 
 	obj_area_init(&viewport.max);
 
@@ -334,9 +505,7 @@ int main() {
 
 	set_ship(obj_ship->pos.row, obj_ship->pos.col, SHIP_TYPE_NORMAL, DIR_NN);
 
-	set_marker(&viewport, obj_ship);
-
-	print_objects(&viewport);
+	set_marker(obj_ship);
 
 	//
 	// Setting the initial cursor is a little hack, because we need an old
@@ -345,78 +514,110 @@ int main() {
 	s_point_set(&hex_idx, 0, 0);
 	obj_old = cursor_mv(&viewport, obj_area_get(1, 1), &hex_idx);
 
+	render_objects(_frame, &viewport, obj_old);
+
+	frame_flush(_frame, _target);
+
 	for (;;) {
 		int c = wgetch(stdscr);
 
+		metrics_frame_start();
+
 		//
-		// Exit with 'q'
+		// Process all pending inputs before the frame is printed. The mouse
+		// motions are coalesced, only the last position is relevant. A pending
+		// motion is applied before the next key or click, so the order is
+		// preserved.
 		//
-		if (c == 'q') {
-			break;
-		}
+		bool quit = false;
+		bool motion = false;
+		s_point motion_idx;
+		int motion_num = 0;
 
-		if (c == KEY_MOUSE) {
-			MEVENT event;
+		nodelay(stdscr, TRUE);
 
-			if (getmouse(&event) != OK) {
-				log_exit_str("Unable to get mouse event!");
-			}
+		do {
 
 			//
-			// From event x/y to relative hex index inside the viewport
+			// Exit with 'q'
 			//
-			hex_get_hex_idx(event.y, event.x, &viewport.max, &hex_idx);
+			if (c == 'q') {
+				quit = true;
+				break;
+			}
 
-			//
-			// From the relative hex index to the absolute hex index.
-			//
-			s_viewport_get_abs(&viewport, &hex_idx, &hex_idx);
+			MEVENT event;
+
+			if (c == KEY_MOUSE) {
 
-			if (event.bstate & BUTTON1_PRESSED) {
-				obj_ship = ship_move(&viewport, obj_ship, obj_area_get(hex_idx.row, hex_idx.col));
+				if (getmouse(&event) != OK) {
+					log_exit_str("Unable to get mouse event!");
+				}
 
+				if (!(event.bstate & BUTTON1_PRESSED)) {
+
+					//
+					// From event x/y to relative hex index inside the viewport
+					//
+					hex_get_hex_idx(event.y, event.x, &viewport.max, &motion_idx);
+
+					motion = true;
+					motion_num++;
+					continue;
+				}
+			}
+
+			if (motion) {
+				obj_old = cursor_motion(&viewport, obj_old, &motion_idx, &hex_idx);
+				motion = false;
+			}
+
+			if (c == KEY_MOUSE) {
+				obj_ship = hg_process_click(&event, &viewport, obj_ship, &hex_idx);
 			} else {
-				obj_old = cursor_mv(&viewport, obj_old, &hex_idx);
+				hg_process_key(c, &viewport, &obj_old, &obj_ship, &hex_idx);
 			}
 
-		} else {
+		} while ((c = wgetch(stdscr)) != ERR);
 
-			switch (c) {
+		nodelay(stdscr, FALSE);
 
-			case KEY_UP:
-				log_debug_str("arrow up");
-				s_point_set(&hex_idx, obj_old->pos.row - 1, obj_old->pos.col)
-				;
-				obj_old = cursor_mv(&viewport, obj_old, &hex_idx);
-				break;
+		if (quit) {
+			break;
+		}
 
-			case KEY_DOWN:
-				log_debug_str("arrow down");
-				s_point_set(&hex_idx, obj_old->pos.row + 1, obj_old->pos.col)
-				;
-				obj_old = cursor_mv(&viewport, obj_old, &hex_idx);
-				break;
+		if (motion) {
+			obj_old = cursor_motion(&viewport, obj_old, &motion_idx, &hex_idx);
+		}
 
-			case KEY_LEFT:
-				log_debug_str("arrow left");
-				s_point_set(&hex_idx, obj_old->pos.row, obj_old->pos.col - 1)
-				;
-				obj_old = cursor_mv(&viewport, obj_old, &hex_idx);
-				break;
+		if (motion_num > 1) {
+			trace_event(TRACE_DEBUG, TRACE_INPUT, "Coalesced mouse motions: %ld", motion_num);
+		}
 
-			case KEY_RIGHT:
-				log_debug_str("arrow right");
-				s_point_set(&hex_idx, obj_old->pos.row, obj_old->pos.col + 1)
-				;
-				obj_old = cursor_mv(&viewport, obj_old, &hex_idx);
-				break;
+		//
+		// Print the objects that changed while processing the input and write
+		// the changed cells to the window.
+		//
+		render_damaged(_frame, &viewport, obj_old);
 
-			case 10:
-				log_debug_str("Enter");
-				obj_ship = ship_move(&viewport, obj_ship, obj_area_get(hex_idx.row, hex_idx.col));
-				break;
-			}
+		if (_metrics_overlay) {
+			metrics_print(_frame, _frame->dim.row - 1);
 		}
+
+		frame_flush(_frame, _target);
+
+		//
+		// At the end of the frame, unused tiles of the object area can be
+		// evicted.
+		//
+		obj_area_evict(&viewport.pos, &viewport.dim);
+
+		//
+		// Refresh the window, so the output is part of the frame.
+		//
+		wrefresh(stdscr);
+
+		metrics_frame_end();
 	}
 
 	log_debug_str("End (before cleanup)");
@@ -23,6 +23,8 @@
  */
 
 #include "hg_common.h"
+#include "hg_color.h"
+#include "hg_color_pair.h"
 
 #include <ncurses.h>
 
@@ -49,16 +51,15 @@ typedef struct {
  * We define an array for the registered colors.
  ******************************************************************************/
 
-#define _COLOR_MAX 64
-
 static size_t _color_num = 0;
 
-static s_color _color_array[_COLOR_MAX];
+static s_color _color_array[COLOR_MAX];
+
+/*******************************************************************************
+ * The flag for the headless mode, which is used for tests and benchmarks.
+ ******************************************************************************/
 
-//
-// An offset for the color id.
-//
-#define _COLOR_START 8
+bool _col_headless = false;
 
 /*******************************************************************************
  * The macro logs the given color.
@@ -116,7 +117,7 @@ short col_color_create(const short r, const short g, const short b) {
 	//
 	// Ensure that there is space for an other s_color_pair.
 	//
-	if (_color_num == _COLOR_MAX) {
+	if (_color_num == COLOR_MAX) {
 		log_exit_str("Too many colors!");
 	}
 
@@ -128,7 +129,7 @@ short col_color_create(const short r, const short g, const short b) {
 	col_ptr->red = r;
 	col_ptr->green = g;
 	col_ptr->blue = b;
-	col_ptr->color = _color_num + _COLOR_START;
+	col_ptr->color = _color_num + COLOR_START;
 
 #ifdef DEBUG
 
@@ -145,7 +146,7 @@ short col_color_create(const short r, const short g, const short b) {
 	//
 	// Initialize the color.
 	//
-	if (init_color(col_ptr->color, col_ptr->red, col_ptr->green, col_ptr->blue)) {
+	if (!_col_headless && init_color(col_ptr->color, col_ptr->red, col_ptr->green, col_ptr->blue)) {
 		log_exit_str("Unable to create color!");
 	}
 
@@ -158,3 +159,15 @@ short col_color_create(const short r, const short g, const short b) {
 
 	return col_ptr->color;
 }
+
+/*******************************************************************************
+ * The function removes all colors. The color pairs refer to the colors, so
+ * they are removed too.
+ ******************************************************************************/
+
+void col_color_reset() {
+
+	_color_num = 0;
+
+	cp_color_pair_reset();
+}
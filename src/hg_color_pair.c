@@ -22,167 +22,113 @@
  * SOFTWARE.
  */
 
+#include <string.h>
+
 #include "hg_common.h"
+#include "hg_color_pair.h"
+#include "hg_trace.h"
 
 #include <ncurses.h>
 
 /*******************************************************************************
- * The definition of the color pair struct contains a foreground and a
- * background color and an id for the color pair.
+ * The color pairs are stored in a lookup table, which is indexed by the
+ * foreground and the background color. The color ids are small numbers (see
+ * COLOR_ID_MAX), so the table is dense. Entries with CP_UNDEF are not
+ * registered yet and are filled lazily, when the color pair is requested.
  ******************************************************************************/
 
-typedef struct {
-
-	short fg;
-	short bg;
-	short cp;
-
-} s_color_pair;
+short _cp_table[COLOR_ID_MAX][COLOR_ID_MAX];
 
 /*******************************************************************************
- * We define an array for the registered colors pairs.
+ * The number of registered color pairs, which is used for the next color pair
+ * id.
  ******************************************************************************/
 
 #define CP_MAX 64
 
-static size_t _cp_num = 0;
-
-static s_color_pair _cp_array[CP_MAX];
+static short _cp_num = 0;
 
 //
 // An offset for the color pair id.
 //
 #define CP_START 8
 
-static bool _is_sorted = false;
-
-/*******************************************************************************
- * The macro logs the given color pair.
- ******************************************************************************/
-
-#define log_color_pair(c) log_debug("color pair: %d fg: %d bg: %d",(c)->cp, (c)->fg, (c)->bg);
-
 /*******************************************************************************
- * The comparison function for the qsort and bsearch functions. It compares two
- * s_color_pair by their foreground and background color.
+ * The function adds a color pair to the lookup table. If the color pair is
+ * already registered, the registered color pair is returned.
  ******************************************************************************/
 
-static int col_color_pair_comp(const void *ptr1, const void *ptr2) {
-
-	const s_color_pair *cp1 = (s_color_pair*) ptr1;
-	const s_color_pair *cp2 = (s_color_pair*) ptr2;
+short cp_color_pair_add(const short fg, const short bg) {
 
 	//
-	// If the foreground colors differ, we do not need to look at the background
-	// color.
+	// Ensure that the colors are valid table indices.
 	//
-	if (cp1->fg != cp2->fg) {
-		return cp1->fg - cp2->fg;
+	if (fg < 0 || fg >= COLOR_ID_MAX || bg < 0 || bg >= COLOR_ID_MAX) {
+		log_exit("Invalid colors fg: %d bg: %d", fg, bg);
 	}
 
-	//
-	// If the foreground colors are equal, we return the difference of the
-	// background colors.
-	//
-	return cp1->bg - cp2->bg;
-}
-
-/*******************************************************************************
- * After new entries are added to the array, it has to be sorted. It is not
- * implemented as a macro, so we need not expose the internal structure of the
- * library.
- ******************************************************************************/
-
-static void cp_color_pair_sort() {
-
-	log_debug("Sorting array with: %ld elements.", _cp_num);
-
-	qsort(_cp_array, _cp_num, sizeof(s_color_pair), col_color_pair_comp);
-
-	//
-	// Mark the array as sorted.
-	//
-	_is_sorted = true;
-}
-
-/*******************************************************************************
- * The function adds a color pair to the array. The array is not sorted. If you
- * want to add more than one color pair, you can do this without sorting the
- * array every time.
- ******************************************************************************/
-
-short cp_color_pair_add(const short fg, const short bg) {
+	if (_cp_table[fg][bg] != CP_UNDEF) {
+		return _cp_table[fg][bg];
+	}
 
 	//
-	// Ensure that there is space for an other s_color_pair.
+	// Ensure that there is space for an other color pair.
 	//
 	if (_cp_num == CP_MAX) {
 		log_exit_str("Too many pairs!");
 	}
 
-	//
-	// Set the array data
-	//
-	s_color_pair *cp_ptr = &_cp_array[_cp_num];
-
-	cp_ptr->fg = fg;
-	cp_ptr->bg = bg;
-	cp_ptr->cp = _cp_num + CP_START;
+	const short cp = _cp_num + CP_START;
 
-	if (init_pair(cp_ptr->cp, cp_ptr->fg, cp_ptr->bg)) {
+	if (!_col_headless && init_pair(cp, fg, bg)) {
 		log_exit_str("Unable to create color pair!");
 	}
 
-	log_color_pair(cp_ptr);
+	_cp_table[fg][bg] = cp;
+
+	trace_event(TRACE_INFO, TRACE_COLOR, "color pair: %ld fg: %ld bg: %ld", cp, fg, bg);
 
 	//
 	// Update the number of pairs
 	//
 	_cp_num++;
 
-	//
-	// If we added a new element, the array is sorted.
-	//
-	_is_sorted = false;
-
-	return cp_ptr->cp;
+	return cp;
 }
 
 /*******************************************************************************
- * The function searches a color pair in our array of registered color pairs. If
- * the color pair was not found, a new color pair is created and added to the
- * array.
+ * The function returns the color pair for the foreground and background color.
+ * If the color pair is not registered, it is created and added to the lookup
+ * table.
  ******************************************************************************/
 
 short cp_color_pair_get(const short fg, const short bg) {
 
-	log_debug("Search fg: %d bg: %d", fg, bg);
+#ifdef DEBUG
 
-	if (!_is_sorted) {
-		cp_color_pair_sort();
-	}
-
-	//
-	// Create a key for the search
 	//
-	s_color_pair key = { .fg = fg, .bg = bg };
-
+	// Ensure that the colors are valid table indices.
 	//
-	// Do the searching.
-	//
-	const s_color_pair *result = bsearch(&key, _cp_array, _cp_num, sizeof(s_color_pair), col_color_pair_comp);
+	if (fg < 0 || fg >= COLOR_ID_MAX || bg < 0 || bg >= COLOR_ID_MAX) {
+		log_exit("Invalid colors fg: %d bg: %d", fg, bg);
+	}
+#endif
 
-	//
-	// If the color pair was found, we can return the id.
-	//
-	if (result != NULL) {
-		log_color_pair(result);
-		return result->cp;
+	if (_cp_table[fg][bg] != CP_UNDEF) {
+		return _cp_table[fg][bg];
 	}
 
-	//
-	// If the color pair was not found in the array, we add it to the array
-	// and return the result.
-	//
 	return cp_color_pair_add(fg, bg);
 }
+
+/*******************************************************************************
+ * The function removes all color pairs. The cached hex images of the rendering
+ * contain color pairs, so the caller has to reset the render cache too.
+ ******************************************************************************/
+
+void cp_color_pair_reset() {
+
+	memset(_cp_table, CP_UNDEF, sizeof(_cp_table));
+
+	_cp_num = 0;
+}
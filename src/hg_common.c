@@ -22,8 +22,25 @@
  * SOFTWARE.
  */
 
+#include <stddef.h>
+
 #include "hg_common.h"
 
+/******************************************************************************
+ * The definitions for the arena. The allocations are aligned for all types,
+ * which includes the header of a block.
+ *****************************************************************************/
+
+#define ARENA_ALIGN _Alignof(max_align_t)
+
+#define arena_align(s) (((s) + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN)
+
+#define ARENA_HEADER arena_align(sizeof(char*))
+
+#define ARENA_BLOCK_MIN 4096
+
+s_arena _arena_turn = { .mem = NULL, .size = 0, .used = 0, .total = 0 };
+
 /******************************************************************************
  * The function allocates memory and terminates the program in case of an
  * error.
@@ -39,3 +56,119 @@ void* xmalloc(const size_t size) {
 
 	return ptr;
 }
+
+/******************************************************************************
+ * The function allocates memory, which is aligned to a cache line. The size is
+ * rounded up to a multiple of the cache line, which is required by
+ * aligned_alloc(). The memory is freed with free().
+ *****************************************************************************/
+
+void* xmalloc_aligned(const size_t size) {
+
+	const size_t size_aligned = (size + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+
+	void *ptr = aligned_alloc(CACHE_LINE, size_aligned);
+
+	if (ptr == NULL) {
+		log_exit("Unable to allocate: %zu aligned bytes of memory!", size_aligned);
+	}
+
+	return ptr;
+}
+
+/******************************************************************************
+ * The function initializes an empty arena. No block is allocated.
+ *****************************************************************************/
+
+void arena_init(s_arena *arena) {
+	arena->mem = NULL;
+	arena->size = 0;
+	arena->used = 0;
+	arena->total = 0;
+}
+
+/******************************************************************************
+ * The function adds a block with the given size to the arena. The current
+ * block is linked with the header of the new block.
+ *****************************************************************************/
+
+static void arena_add_block(s_arena *arena, const size_t size) {
+
+	log_debug("Adding arena block with size: %zu", size);
+
+	char *block = xmalloc_aligned(size);
+
+	*(char**) block = arena->mem;
+
+	arena->mem = block;
+	arena->size = size;
+	arena->used = ARENA_HEADER;
+}
+
+/******************************************************************************
+ * The function allocates memory from the arena. If the current block is too
+ * small, a new block is added, which is at least twice as large.
+ *****************************************************************************/
+
+void* arena_alloc(s_arena *arena, const size_t size) {
+
+	const size_t size_aligned = arena_align(size);
+
+	if (arena->mem == NULL || arena->used + size_aligned > arena->size) {
+
+		size_t block = arena->size < ARENA_BLOCK_MIN ? ARENA_BLOCK_MIN : arena->size * 2;
+
+		while (block < ARENA_HEADER + size_aligned) {
+			block *= 2;
+		}
+
+		arena_add_block(arena, block);
+	}
+
+	void *ptr = arena->mem + arena->used;
+
+	arena->used += size_aligned;
+	arena->total += size_aligned;
+
+	return ptr;
+}
+
+/******************************************************************************
+ * The function releases all allocations of the arena. If the arena has more
+ * than one block, the blocks are replaced by a single block, that is large
+ * enough for all allocations since the last reset.
+ *****************************************************************************/
+
+void arena_reset(s_arena *arena) {
+
+	if (arena->mem != NULL && *(char**) arena->mem != NULL) {
+
+		const size_t size = ARENA_HEADER + arena->total;
+
+		arena_free(arena);
+
+		arena_add_block(arena, size);
+
+	} else {
+		arena->used = ARENA_HEADER;
+	}
+
+	arena->total = 0;
+}
+
+/******************************************************************************
+ * The function frees all blocks of the arena.
+ *****************************************************************************/
+
+void arena_free(s_arena *arena) {
+
+	char *block = arena->mem;
+
+	while (block != NULL) {
+		char *prev = *(char**) block;
+		free(block);
+		block = prev;
+	}
+
+	arena_init(arena);
+}
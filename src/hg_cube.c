@@ -0,0 +1,238 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <math.h>
+
+#include "hg_cube.h"
+
+/******************************************************************************
+ * The offsets of the neighbours in cube coordinates, indexed by the direction
+ * (q, r, s). Unlike the offset coordinates, the offsets do not depend on the
+ * parity of the column.
+ *****************************************************************************/
+
+static const s_cube _cube_dir[DIR_NUM] = {
+
+	{ 0, -1, 1 }, // DIR_NN
+	{ 1, -1, 0 }, // DIR_NE
+	{ 1, 0, -1 }, // DIR_SE
+	{ 0, 1, -1 }, // DIR_SS
+	{ -1, 1, 0 }, // DIR_SW
+	{ -1, 0, 1 }  // DIR_NW
+};
+
+/******************************************************************************
+ * The function converts offset coordinates to cube coordinates. The odd
+ * columns are shifted down, so the row has to be corrected by half of the
+ * column (rounded down, which is the reason for the & 1).
+ *****************************************************************************/
+
+void cube_from_offset(const s_point *offset, s_cube *cube) {
+
+	const int q = offset->col;
+	const int r = offset->row - (offset->col - (offset->col & 1)) / 2;
+
+	s_cube_set(cube, q, r);
+}
+
+/******************************************************************************
+ * The function converts cube coordinates to offset coordinates.
+ *****************************************************************************/
+
+void cube_to_offset(const s_cube *cube, s_point *offset) {
+
+	offset->col = cube->q;
+	offset->row = cube->r + (cube->q - (cube->q & 1)) / 2;
+}
+
+/******************************************************************************
+ * The function computes the distance of two hex fields, which is the number
+ * of steps from one to the other.
+ *****************************************************************************/
+
+int cube_distance(const s_cube *cube_1, const s_cube *cube_2) {
+
+	const int dq = abs(cube_1->q - cube_2->q);
+	const int dr = abs(cube_1->r - cube_2->r);
+	const int ds = abs(cube_1->s - cube_2->s);
+
+	return (dq + dr + ds) / 2;
+}
+
+/******************************************************************************
+ * The function computes the distance of two hex fields in offset coordinates.
+ *****************************************************************************/
+
+int cube_offset_distance(const s_point *offset_1, const s_point *offset_2) {
+	s_cube cube_1, cube_2;
+
+	cube_from_offset(offset_1, &cube_1);
+	cube_from_offset(offset_2, &cube_2);
+
+	return cube_distance(&cube_1, &cube_2);
+}
+
+/******************************************************************************
+ * The function computes the neighbour of a hex field in a given direction.
+ *****************************************************************************/
+
+void cube_neighbour(const s_cube *from, const e_dir dir, s_cube *to) {
+
+	to->q = from->q + _cube_dir[dir].q;
+	to->r = from->r + _cube_dir[dir].r;
+	to->s = from->s + _cube_dir[dir].s;
+}
+
+/******************************************************************************
+ * The function rotates a hex field around a center by a number of 60 degree
+ * steps. Positive steps rotate clockwise, so DIR_NN becomes DIR_NE.
+ *****************************************************************************/
+
+void cube_rotate(const s_cube *center, const s_cube *from, const int steps, s_cube *to) {
+
+	int q = from->q - center->q;
+	int r = from->r - center->r;
+	int s = from->s - center->s;
+
+	//
+	// A clockwise step is (q, r, s) => (-r, -s, -q), so 6 steps are the
+	// identity.
+	//
+	for (int i = ((steps % DIR_NUM) + DIR_NUM) % DIR_NUM; i > 0; i--) {
+		const int tmp = q;
+		q = -r;
+		r = -s;
+		s = -tmp;
+	}
+
+	to->q = center->q + q;
+	to->r = center->r + r;
+	to->s = center->s + s;
+}
+
+/******************************************************************************
+ * The function computes the hex fields with a given distance to the center.
+ * The ring starts north of the center and goes clockwise. The array has to
+ * have cube_ring_num(radius) elements. The function returns the number of
+ * hex fields.
+ *****************************************************************************/
+
+int cube_ring(const s_cube *center, const int radius, s_cube *ring) {
+
+	if (radius == 0) {
+		ring[0] = *center;
+		return 1;
+	}
+
+	//
+	// Start at the north corner of the ring.
+	//
+	s_cube cube;
+	s_cube_set(&cube, center->q + _cube_dir[DIR_NN].q * radius, center->r + _cube_dir[DIR_NN].r * radius);
+
+	int num = 0;
+
+	//
+	// Each edge of the ring goes 120 degree clockwise to the direction of the
+	// corner, where it starts (DIR_NN corner => DIR_SE edge).
+	//
+	for (int edge = 0; edge < DIR_NUM; edge++) {
+		const e_dir dir = (edge + 2) % DIR_NUM;
+
+		for (int i = 0; i < radius; i++) {
+			ring[num++] = cube;
+			cube_neighbour(&cube, dir, &cube);
+		}
+	}
+
+	return num;
+}
+
+/******************************************************************************
+ * The function computes the hex fields with a distance less or equal than the
+ * radius to the center. The hex fields are ordered by the distance, ring after
+ * ring. The array has to have cube_spiral_num(radius) elements. The function
+ * returns the number of hex fields.
+ *****************************************************************************/
+
+int cube_spiral(const s_cube *center, const int radius, s_cube *spiral) {
+	int num = 0;
+
+	for (int i = 0; i <= radius; i++) {
+		num += cube_ring(center, i, &spiral[num]);
+	}
+
+	return num;
+}
+
+/******************************************************************************
+ * The function rounds fractional cube coordinates to the nearest hex field.
+ * The component with the largest rounding error is recomputed from the others.
+ *****************************************************************************/
+
+static void cube_round(const double q, const double r, const double s, s_cube *cube) {
+
+	double rq = round(q);
+	double rr = round(r);
+	double rs = round(s);
+
+	const double dq = fabs(rq - q);
+	const double dr = fabs(rr - r);
+	const double ds = fabs(rs - s);
+
+	if (dq > dr && dq > ds) {
+		rq = -rr - rs;
+	} else if (dr > ds) {
+		rr = -rq - rs;
+	}
+
+	s_cube_set(cube, (int) rq, (int) rr);
+}
+
+/******************************************************************************
+ * The function computes the hex fields of a line from one hex field to
+ * another, including both. The line is sampled at distance + 1 points, which
+ * are rounded to hex fields. The points are moved by a small epsilon, so that
+ * points on an edge are rounded consistently. The array has to have distance
+ * + 1 elements. The function returns the number of hex fields.
+ *****************************************************************************/
+
+#define CUBE_EPSILON 1e-6
+
+int cube_line(const s_cube *from, const s_cube *to, s_cube *line) {
+
+	const int dist = cube_distance(from, to);
+
+	const double q = from->q + CUBE_EPSILON;
+	const double r = from->r + CUBE_EPSILON;
+	const double s = from->s - 2 * CUBE_EPSILON;
+
+	for (int i = 0; i <= dist; i++) {
+		const double t = dist == 0 ? 0.0 : (double) i / dist;
+
+		cube_round(q + (to->q - from->q) * t, r + (to->r - from->r) * t, s + (to->s - from->s) * t, &line[i]);
+	}
+
+	return dist + 1;
+}
@@ -24,6 +24,7 @@
 
 #include "hg_dir.h"
 #include "hg_common.h"
+#include "hg_trace.h"
 
 /******************************************************************************
  * Two macros that allows to turn to left / right, depending on the current
@@ -125,7 +126,7 @@ e_dir e_dir_mv(const e_dir dir, const char chr) {
 		;
 	}
 
-	log_debug("char: %c dir-from: %s dir-to: %s", chr, e_dir_str(dir), e_dir_str(result));
+	trace_event(TRACE_DEBUG, TRACE_AREA, "char: %ld dir-from: %ld dir-to: %ld", chr, dir, result);
 
 	return result;
 }
@@ -0,0 +1,153 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "hg_frame.h"
+#include "hg_metrics.h"
+#include "hg_trace.h"
+
+/******************************************************************************
+ * The function creates a frame with a given dimension. The current and the
+ * previous cells are blank, which is the content of a new render target.
+ *****************************************************************************/
+
+s_frame* frame_create(const s_point *dim) {
+
+	log_debug("Creating frame with: %d/%d", dim->row, dim->col);
+
+	s_frame *frame = xmalloc(sizeof(s_frame));
+
+	s_point_copy(&frame->dim, dim);
+
+	frame->cur = xmalloc(sizeof(s_cell) * dim->row * dim->col);
+	frame->prev = xmalloc(sizeof(s_cell) * dim->row * dim->col);
+
+	target_cells_blank(frame->cur, dim->row * dim->col);
+	target_cells_blank(frame->prev, dim->row * dim->col);
+
+	return frame;
+}
+
+/******************************************************************************
+ * The function frees the frame.
+ *****************************************************************************/
+
+void frame_free(s_frame *frame) {
+	log_debug_str("Freeing the frame!");
+
+	free(frame->cur);
+	free(frame->prev);
+	free(frame);
+}
+
+/******************************************************************************
+ * The function sets a rectangle of the current cells to blank. The rectangle
+ * is clipped to the frame.
+ *****************************************************************************/
+
+void frame_erase(s_frame *frame, const int row, const int col, const int rows, const int cols) {
+
+	const int row_start = row < 0 ? 0 : row;
+	const int col_start = col < 0 ? 0 : col;
+
+	const int row_end = row + rows < frame->dim.row ? row + rows : frame->dim.row;
+	const int col_end = col + cols < frame->dim.col ? col + cols : frame->dim.col;
+
+	for (int r = row_start; r < row_end; r++) {
+		for (int c = col_start; c < col_end; c++) {
+			cell_set_blank(frame_cell(frame, frame->cur, r, c));
+		}
+	}
+}
+
+/******************************************************************************
+ * The function shifts the content of the frame and the render target. The
+ * previous cells are shifted with the target, so they are still the content
+ * of the target and the next flush only writes the cells that changed after
+ * the shift.
+ *****************************************************************************/
+
+void frame_shift(s_frame *frame, s_target *target, const int rows, const int cols) {
+
+	trace_event(TRACE_DEBUG, TRACE_RENDER, "Shift rows: %ld cols: %ld", rows, cols);
+
+	target_cells_shift(&frame->dim, frame->cur, rows, cols);
+	target_cells_shift(&frame->dim, frame->prev, rows, cols);
+
+	target_shift(target, rows, cols);
+}
+
+/******************************************************************************
+ * The function writes the cells that changed since the last flush to the
+ * render target. Adjacent changed cells of a row are written as a single run,
+ * even if they belong to different hex fields or have different color pairs.
+ * The cells of a run are contiguous in the current buffer, so they are passed
+ * to the target without copying. The function returns the number of written
+ * cells.
+ *****************************************************************************/
+
+int frame_flush(s_frame *frame, s_target *target) {
+	s_cell *cur, *prev;
+	int num = 0;
+	int run_start;
+
+	for (int row = 0; row < frame->dim.row; row++) {
+
+		int col = 0;
+
+		while (col < frame->dim.col) {
+
+			//
+			// Skip the cells that did not change.
+			//
+			if (frame_cell_same(frame_cell(frame, frame->cur, row, col), frame_cell(frame, frame->prev, row, col))) {
+				col++;
+				continue;
+			}
+
+			//
+			// Collect the run of changed cells and update the previous cells.
+			//
+			for (run_start = col; col < frame->dim.col; col++) {
+
+				cur = frame_cell(frame, frame->cur, row, col);
+				prev = frame_cell(frame, frame->prev, row, col);
+
+				if (frame_cell_same(cur, prev)) {
+					break;
+				}
+
+				*prev = *cur;
+			}
+
+			target_write(target, row, run_start, frame_cell(frame, frame->cur, row, run_start), col - run_start);
+			num += col - run_start;
+		}
+	}
+
+	trace_event(TRACE_DEBUG, TRACE_RENDER, "Flushed cells: %ld", num);
+
+	metrics_add(cells, num);
+
+	return num;
+}
@@ -24,18 +24,12 @@
 
 #include "hg_hex.h"
 #include "hg_color_pair.h"
+#include "hg_trace.h"
 
 /******************************************************************************
- * The function computes the hex index from a mouse event, which is the
- * position of the cursor.
- *
- * To compute the index, the columns are split into blocks of 3 columns. There
- * are two cases which are handled separately:
- *
- * - the left column of the block
- * - the center and right column of the block
- *
- * Three hex fields:
+ * The layout of the hex fields is periodic. A tile of 4 rows and 6 columns
+ * (two hex columns, where the odd column is shifted down by 2 rows) repeats
+ * in both directions:
  *
  *  ##    ##
  * ####  ####
@@ -44,70 +38,50 @@
  *    OOOO
  *     OO
  *
- * The three hex fields spited into blocks of three columns. The last block is
- * not complete.
- *
- *  ##        ##
- * ###  #    ###  #
- * ###  #OO  ###  #
- *  ##  OOO  O##
- *      OOO  O
- *       OO
+ * The table contains for each cell of the tile the offset of the hex index
+ * relative to the tile. The tile with the index (win_row / 4, win_col / 6)
+ * has the hex index (win_row / 4, 2 * (win_col / 6)). The cells of the upper
+ * part of the odd column and the corners belong to the hex fields of the
+ * row above (-1) and of the column to the left (-1).
  *****************************************************************************/
 
-void hex_get_hex_idx(const int win_row, const int win_col, const s_point *hex_max, s_point *hex_idx) {
+#define HEX_TILE_ROWS 4
 
-	const int col_3_idx = win_col / 3;
+#define HEX_TILE_COLS 6
 
-	//
-	// Handle the left column of the block
-	//
-	if (win_col % 3 == 0) {
-		const int win_row_offset = win_row - 1;
+static const s_point _hex_tile[HEX_TILE_ROWS][HEX_TILE_COLS] = {
 
-		if (win_row_offset < 0) {
-			s_point_set(hex_idx, -1, -1);
+	{ { -1, -1 }, { 0, 0 }, { 0, 0 }, { -1, 1 }, { -1, 1 }, { -1, 1 } },
 
-		} else {
-			hex_idx->col = col_3_idx - ((win_row_offset / 2 + col_3_idx) % 2);
+	{ { 0, 0 }, { 0, 0 }, { 0, 0 }, { 0, 0 }, { -1, 1 }, { -1, 1 } },
 
-			if (hex_idx->col < 0) {
-				s_point_set(hex_idx, -1, -1);
+	{ { 0, 0 }, { 0, 0 }, { 0, 0 }, { 0, 0 }, { 0, 1 }, { 0, 1 } },
 
-			} else {
-				hex_idx->row = win_row_offset / 4;
-			}
-		}
+	{ { 0, -1 }, { 0, 0 }, { 0, 0 }, { 0, 1 }, { 0, 1 }, { 0, 1 } }
+};
 
-	}
-
-	//
-	// Handle the center and right column of the block.
-	//
-	else {
+/******************************************************************************
+ * The function computes the hex index from a mouse event, which is the
+ * position of the cursor. The hex index is the index of the tile plus the
+ * offset from the table. If the position is not inside a hex field, the hex
+ * index is -1/-1.
+ *****************************************************************************/
 
-		//
-		// The rows have toggling offset of 0 and 2.
-		//
-		const int win_row_offset = win_row - ((col_3_idx % 2 == 1) ? 2 : 0);
+void hex_get_hex_idx(const int win_row, const int win_col, const s_point *hex_max, s_point *hex_idx) {
 
-		if (win_row_offset < 0) {
-			s_point_set(hex_idx, -1, -1);
+	const s_point *offset = &_hex_tile[win_row % HEX_TILE_ROWS][win_col % HEX_TILE_COLS];
 
-		} else {
-			hex_idx->row = win_row_offset / 4;
-			hex_idx->col = col_3_idx;
-		}
-	}
+	hex_idx->row = win_row / HEX_TILE_ROWS + offset->row;
+	hex_idx->col = win_col / HEX_TILE_COLS * 2 + offset->col;
 
 	//
 	// Ensure that the hex index is inside the valid ranges.
 	//
-	if (hex_idx->row >= hex_max->row || hex_idx->col >= hex_max->col) {
+	if (!s_point_inside(hex_max, hex_idx)) {
 		s_point_set(hex_idx, -1, -1);
 	}
 
-	log_debug("Event: %d/%d hex: %d/%d", win_row, win_col, hex_idx->row, hex_idx->col);
+	trace_event(TRACE_DEBUG, TRACE_INPUT, "Event: %ld/%ld hex: %ld/%ld", win_row, win_col, hex_idx->row, hex_idx->col);
 }
 
 /******************************************************************************
@@ -125,11 +99,13 @@ void hex_field_set_corners(s_hex_field *hex_field) {
 }
 
 /******************************************************************************
- * The function prints a hex field, with a foreground and a background hex
- * field.
+ * The function composes a hex image from a foreground and a background hex
+ * field. The foreground hex field is optional. The characters and the color
+ * pairs are resolved, so the image can be printed without further lookups.
+ * Cells with the empty character of the background are space cells.
  *****************************************************************************/
 
-void hex_field_print(WINDOW *win, const s_point *pos_ul, const s_hex_field *hex_field_fg, const s_hex_field *hex_field_bg) {
+void hex_image_compose(s_hex_image *hex_image, const s_hex_field *hex_field_fg, const s_hex_field *hex_field_bg) {
 
 	//
 	// Pointer to a constant value not a constant pointer
@@ -137,9 +113,8 @@ void hex_field_print(WINDOW *win, const s_point *pos_ul, const s_hex_field *hex_
 	const s_hex_point *hex_point_fg;
 	const s_hex_point *hex_point_bg;
 
-	short color_pair;
+	s_cell *cell;
 	short color_bg;
-	wchar_t *chr;
 
 	//
 	// Loop over the points of the hex field
@@ -147,10 +122,13 @@ void hex_field_print(WINDOW *win, const s_point *pos_ul, const s_hex_field *hex_
 	for (int row = 0; row < HEX_SIZE; row++) {
 		for (int col = 0; col < HEX_SIZE; col++) {
 
+			cell = &hex_image->cell[row][col];
+
 			//
-			// Ignore the corners of the hex field
+			// Ignore the corners of the hex field.
 			//
 			if (hex_field_is_corner(row, col)) {
+				cell_set_blank(cell);
 				continue;
 			}
 
@@ -160,13 +138,13 @@ void hex_field_print(WINDOW *win, const s_point *pos_ul, const s_hex_field *hex_
 			hex_point_bg = &hex_field_bg->point[row][col];
 
 			//
-			// If the foreground hex field is undefined, we print the hex field
+			// If the foreground hex field is undefined, we use the hex field
 			// of the space. This means, there is no ship or something else in
 			// the foreground.
 			//
 			if (hex_field_fg == NULL || hex_field_fg->point[row][col].chr == W_NULL) {
-				chr = hex_point_bg->chr;
-				color_pair = cp_color_pair_get(hex_point_bg->fg, hex_point_bg->bg);
+				cell->chr = hex_point_bg->chr[0] == W_EMPTY[0] ? HEX_CHR_SPACE : hex_point_bg->chr[0];
+				cell->cp = cp_color_pair_lookup(hex_point_bg->fg, hex_point_bg->bg);
 			}
 
 			//
@@ -179,21 +157,50 @@ void hex_field_print(WINDOW *win, const s_point *pos_ul, const s_hex_field *hex_
 				//
 				hex_point_fg = &hex_field_fg->point[row][col];
 
-				chr = hex_point_fg->chr;
+				cell->chr = hex_point_fg->chr[0];
 
 				//
 				// If the foreground hex field has a background color, we use
 				// this. Otherwise we used the background color of the space.
 				//
 				color_bg = hex_point_fg->bg == COLOR_UNDEF ? hex_point_bg->bg : hex_point_fg->bg;
-				color_pair = cp_color_pair_get(hex_point_fg->fg, color_bg);
+				cell->cp = cp_color_pair_lookup(hex_point_fg->fg, color_bg);
 			}
+		}
+	}
+}
+
+/******************************************************************************
+ * The function prints a hex image to the frame. The space cells are printed
+ * as stars or blanks, depending on the star mask of the hex field. Cells
+ * outside the frame are ignored.
+ *****************************************************************************/
+
+void hex_image_print(s_frame *frame, const s_point *pos_ul, const s_hex_image *hex_image, const unsigned short stars) {
+	const s_cell *cell;
+	wchar_t chr;
+
+	for (int row = 0; row < HEX_SIZE; row++) {
+		for (int col = 0; col < HEX_SIZE; col++) {
 
 			//
-			// Set the color pair and print the character.
+			// Ignore the corners of the hex field and the cells outside the
+			// frame.
 			//
-			attron(COLOR_PAIR(color_pair));
-			mvwaddwstr(win, pos_ul->row + row, pos_ul->col + col, chr);
+			if (hex_field_is_corner(row, col) || !frame_inside(frame, pos_ul->row + row, pos_ul->col + col)) {
+				continue;
+			}
+
+			cell = &hex_image->cell[row][col];
+
+			if (cell->chr != HEX_CHR_SPACE) {
+				chr = cell->chr;
+
+			} else {
+				chr = (stars & hex_star_bit(row, col)) ? W_STAR[0] : W_EMPTY[0];
+			}
+
+			frame_set(frame, pos_ul->row + row, pos_ul->col + col, chr, cell->cp);
 		}
 	}
 }
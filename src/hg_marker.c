@@ -23,16 +23,17 @@
  */
 
 #include "hg_marker.h"
+#include "hg_pool.h"
 
 /******************************************************************************
- * The definition of the marker array.
+ * The definition of the marker pool. The markers of a turn are released
+ * together, so the pool grows only to the maximum number of markers of a
+ * turn.
  *****************************************************************************/
 
-#define MKR_MAX 32
+#define MKR_CHUNK 64
 
-static s_marker _mkr_array[MKR_MAX];
-
-static int _mkr_num_used = 0;
+static s_pool _mkr_pool;
 
 /******************************************************************************
  * The initialization function calls the initialization functions for the
@@ -42,23 +43,27 @@ static int _mkr_num_used = 0;
 void s_marker_init() {
 	log_debug_str("Initialize the markers!");
 
+	pool_init(&_mkr_pool, "marker", sizeof(s_marker), MKR_CHUNK);
+
 	s_marker_move_init();
 }
 
 /******************************************************************************
- * The function gets the next unused marker from the marker array.
+ * The function frees the markers.
  *****************************************************************************/
 
-static s_marker* s_marker_get(const e_marker type) {
+void s_marker_free() {
 
-	//
-	// Ensure that there is an unused marker struct.
-	//
-	if (_mkr_num_used >= MKR_MAX) {
-		log_exit_str("No more marker left!");
-	}
+	pool_free(&_mkr_pool);
+}
+
+/******************************************************************************
+ * The function gets an unused marker from the marker pool.
+ *****************************************************************************/
+
+static s_marker* s_marker_get(const e_marker type) {
 
-	s_marker *marker = &_mkr_array[_mkr_num_used++];
+	s_marker *marker = pool_alloc(&_mkr_pool);
 
 	//
 	// Set the marker type
@@ -83,13 +88,13 @@ s_marker* s_marker_get_move_marker(const e_marker type, const e_dir dir) {
 }
 
 /******************************************************************************
- *The function resets the array of s_marker instances.
+ * The function releases all s_marker instances. Pointers to the markers are
+ * stale afterwards. The move markers are released with the reset of the turn
+ * arena.
  *****************************************************************************/
 
 void s_marker_release() {
-	_mkr_num_used = 0;
-
-	s_marker_move_release();
+	pool_release_all(&_mkr_pool);
 }
 
 /******************************************************************************
@@ -106,6 +111,11 @@ void s_marker_add_to_field(const s_marker *marker, const int color_idx, const bo
 		return;
 	}
 
+	//
+	// Ensure that the marker was not released.
+	//
+	pool_check(&_mkr_pool, marker);
+
 	//
 	// Select the marker type and delegate the call.
 	//
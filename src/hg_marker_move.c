@@ -55,16 +55,6 @@ static void s_marker_move_init_arows() {
 	_arrow[DIR_NW] = MV_NW;
 }
 
-/******************************************************************************
- * The definition of the move marker array.
- *****************************************************************************/
-
-#define MKR_MAX 32
-
-static s_marker_move _mkr_mv_array[MKR_MAX];
-
-static int _mkr_mv_num_used = 0;
-
 /******************************************************************************
  * The definition of the move marker colors. We have 3 colors for the shading
  * and a normal and highlighted color.
@@ -126,35 +116,20 @@ void s_marker_move_init() {
 }
 
 /******************************************************************************
- * The function returns the next unused s_marker_move instance from the array
- * and initializes it with the given direction.
+ * The function returns a s_marker_move instance and initializes it with the
+ * given direction. The move markers live for a turn, so they are allocated
+ * from the turn arena and released with its reset.
  *****************************************************************************/
 
 s_marker_move* s_marker_move_get(const e_dir dir) {
 
-	//
-	// Ensure that there is an unused marker struct.
-	//
-	if (_mkr_mv_num_used >= MKR_MAX) {
-		log_exit_str("No more marker left!");
-	}
-
-	s_marker_move *marker_move = &_mkr_mv_array[_mkr_mv_num_used++];
+	s_marker_move *marker_move = arena_alloc(&_arena_turn, sizeof(s_marker_move));
 
 	marker_move->dir = dir;
 
 	return marker_move;
 }
 
-/******************************************************************************
- * The function resets the array of s_marker_move instances. This simple means
- * to set the index of the next unused move marker to 0.
- *****************************************************************************/
-
-void s_marker_move_release() {
-	_mkr_mv_num_used = 0;
-}
-
 /******************************************************************************
  * The function adds the move marker to the hex field. It changes the
  * background color and adds arrows to the field.
@@ -0,0 +1,226 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <time.h>
+
+#include "hg_metrics.h"
+
+/******************************************************************************
+ * The metrics of the current frame and the history of the finished frames,
+ * which is dumped on exit.
+ *****************************************************************************/
+
+s_metrics _metrics;
+
+static s_metrics *_metrics_history = NULL;
+
+static long _metrics_num = 0;
+
+static long _metrics_size = 0;
+
+//
+// The history grows by this number of frames.
+//
+#define METRICS_CHUNK 1024
+
+//
+// The start time of the current frame.
+//
+static double _metrics_start;
+
+/******************************************************************************
+ * The function returns the time in seconds from a monotonic clock.
+ *****************************************************************************/
+
+static double metrics_time() {
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) {
+		log_exit_str("Unable to get time!");
+	}
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/******************************************************************************
+ * The file descriptor, whose output is counted. ncurses writes its output
+ * buffer with write() to the file descriptor of the terminal and not to the
+ * FILE stream of newterm(), so the bytes are counted by a wrapper of write(),
+ * which calls metrics_count_write(). Without a file descriptor, the bytes are
+ * not available.
+ *****************************************************************************/
+
+static int _metrics_fd = -1;
+
+/******************************************************************************
+ * The function sets the file descriptor, whose output is counted.
+ *****************************************************************************/
+
+void metrics_count_fd(const int fd) {
+	_metrics_fd = fd;
+}
+
+/******************************************************************************
+ * The function counts the result of a write() call, if the bytes were written
+ * to the counted file descriptor.
+ *****************************************************************************/
+
+void metrics_count_write(const int fd, const long result) {
+
+	if (fd == _metrics_fd && result > 0) {
+		metrics_add(bytes, result);
+	}
+}
+
+/******************************************************************************
+ * The function starts a new frame, which resets the counters.
+ *****************************************************************************/
+
+void metrics_frame_start() {
+
+	memset(&_metrics, 0, sizeof(s_metrics));
+
+	_metrics_start = metrics_time();
+}
+
+/******************************************************************************
+ * The function ends the current frame and adds its metrics to the history.
+ *****************************************************************************/
+
+void metrics_frame_end() {
+
+	_metrics.time = metrics_time() - _metrics_start;
+
+	if (_metrics_num == _metrics_size) {
+		_metrics_size += METRICS_CHUNK;
+
+		_metrics_history = realloc(_metrics_history, sizeof(s_metrics) * _metrics_size);
+
+		if (_metrics_history == NULL) {
+			log_exit("Unable to allocate: %ld metrics", _metrics_size);
+		}
+	}
+
+	_metrics_history[_metrics_num++] = _metrics;
+}
+
+/******************************************************************************
+ * The function returns the metrics of the last finished frame or NULL if there
+ * is none.
+ *****************************************************************************/
+
+const s_metrics* metrics_last() {
+
+	if (_metrics_num == 0) {
+		return NULL;
+	}
+
+	return &_metrics_history[_metrics_num - 1];
+}
+
+/******************************************************************************
+ * The function writes the bytes of the metrics to the buffer or "n/a" if the
+ * bytes are not counted.
+ *****************************************************************************/
+
+#define METRICS_NUM 24
+
+static void metrics_bytes_str(const s_metrics *metrics, char *buf) {
+
+	if (_metrics_fd < 0) {
+		snprintf(buf, METRICS_NUM, "n/a");
+	} else {
+		snprintf(buf, METRICS_NUM, "%ld", metrics->bytes);
+	}
+}
+
+/******************************************************************************
+ * The function prints the metrics of the last finished frame to a row of the
+ * frame. It is printed after the objects, so it is an overlay.
+ *****************************************************************************/
+
+#define METRICS_LINE 128
+
+void metrics_print(s_frame *frame, const int row) {
+	char line[METRICS_LINE];
+	char bytes[METRICS_NUM];
+
+	const s_metrics *metrics = metrics_last();
+
+	if (metrics == NULL || row < 0 || row >= frame->dim.row) {
+		return;
+	}
+
+	metrics_bytes_str(metrics, bytes);
+
+	const int len = snprintf(line, METRICS_LINE, " frame: %ld time: %.0f us hexes: %ld cells: %ld cp: %ld miss: %ld bytes: %s ", _metrics_num, metrics->time * 1e6, metrics->hexes, metrics->cells,
+			metrics->cp_lookups, metrics->cache_misses, bytes);
+
+	for (int col = 0; col < len && col < frame->dim.col; col++) {
+		frame_set(frame, row, col, line[col], 0);
+	}
+}
+
+/******************************************************************************
+ * The function writes the history of the metrics to a csv file.
+ *****************************************************************************/
+
+void metrics_dump(const char *path) {
+	char bytes[METRICS_NUM];
+
+	log_debug("Writing metrics to: %s", path);
+
+	FILE *file = fopen(path, "w");
+
+	if (file == NULL) {
+		log_exit("Unable to open file: %s", path);
+	}
+
+	fprintf(file, "frame,time_us,hexes,cells,cp_lookups,cache_misses,bytes\n");
+
+	for (long i = 0; i < _metrics_num; i++) {
+		const s_metrics *metrics = &_metrics_history[i];
+
+		metrics_bytes_str(metrics, bytes);
+
+		fprintf(file, "%ld,%.1f,%ld,%ld,%ld,%ld,%s\n", i, metrics->time * 1e6, metrics->hexes, metrics->cells, metrics->cp_lookups, metrics->cache_misses, bytes);
+	}
+
+	fclose(file);
+}
+
+/******************************************************************************
+ * The function frees the history of the metrics.
+ *****************************************************************************/
+
+void metrics_free() {
+	log_debug_str("Freeing the metrics!");
+
+	free(_metrics_history);
+
+	_metrics_history = NULL;
+	_metrics_num = 0;
+	_metrics_size = 0;
+}
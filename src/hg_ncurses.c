@@ -23,6 +23,7 @@
  */
 
 #include "hg_common.h"
+#include "hg_trace.h"
 
 #include <ncurses.h>
 
@@ -98,6 +99,15 @@ void ncur_init() {
 		log_exit_str("Unable to enable the keypad of the terminal.");
 	}
 
+	//
+	// Allow ncurses to use the insert / delete line features and the scroll
+	// region of the terminal for scrolled windows. Without it, ncurses seldom
+	// uses them.
+	//
+	if (idlok(stdscr, TRUE) == ERR) {
+		log_exit_str("Unable to enable insert / delete line.");
+	}
+
 	//
 	// Switch off the cursor.
 	//
@@ -127,3 +137,84 @@ void ncur_exit() {
 
 	ncur_finish_mouse();
 }
+
+/******************************************************************************
+ * The function shifts the content of the window by a number of rows and
+ * columns. Positive values shift the content down / right, negative values
+ * shift it up / left. The uncovered cells are blank.
+ *
+ * Vertical shifts are done with wscrl(), so ncurses can use the scrolling of
+ * the terminal (idlok() is enabled in ncur_init()). Terminals cannot scroll
+ * horizontally, so horizontal shifts copy the cells of each line, which
+ * changes every cell of the window. ncurses sends the changed cells, which is
+ * a full repaint of the window.
+ *****************************************************************************/
+
+void ncur_win_shift(WINDOW *win, const int rows, const int cols) {
+
+	const int win_rows = getmaxy(win);
+	const int win_cols = getmaxx(win);
+
+	trace_event(TRACE_DEBUG, TRACE_RENDER, "Shift window rows: %ld cols: %ld", rows, cols);
+
+	//
+	// Scrolling is only enabled while shifting. Otherwise printing the lower
+	// right corner of the window would scroll it.
+	//
+	if (rows != 0) {
+		scrollok(win, TRUE);
+
+		if (wscrl(win, -rows) == ERR) {
+			log_exit("Unable to scroll window by: %d", rows);
+		}
+
+		scrollok(win, FALSE);
+	}
+
+	if (cols == 0 || abs(cols) >= win_cols) {
+		return;
+	}
+
+	cchar_t line[win_cols + 1];
+	cchar_t blank[win_cols];
+
+	const int num = win_cols - abs(cols);
+
+	//
+	// Adding cells merges the current attributes of the window, so they are
+	// reset while shifting.
+	//
+	attr_t attrs;
+	short pair;
+
+	wattr_get(win, &attrs, &pair, NULL);
+	wattr_set(win, A_NORMAL, 0, NULL);
+
+	for (int i = 0; i < abs(cols); i++) {
+		setcchar(&blank[i], W_EMPTY, A_NORMAL, 0, NULL);
+	}
+
+	for (int row = 0; row < win_rows; row++) {
+
+		//
+		// Shift the content to the right and blank the left cells.
+		//
+		if (cols > 0) {
+			mvwin_wchnstr(win, row, 0, line, num);
+			mvwadd_wchnstr(win, row, cols, line, num);
+			mvwadd_wchnstr(win, row, 0, blank, cols);
+		}
+
+		//
+		// Shift the content to the left and blank the right cells.
+		//
+		else {
+			mvwin_wchnstr(win, row, -cols, line, num);
+			mvwadd_wchnstr(win, row, 0, line, num);
+			wmove(win, row, num);
+			wclrtoeol(win);
+		}
+	}
+
+	wattr_set(win, attrs, pair, NULL);
+}
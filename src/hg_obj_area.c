@@ -24,158 +24,458 @@
 
 #include "hg_obj_area.h"
 #include "hg_common.h"
+#include "hg_trace.h"
 
 /******************************************************************************
- * The definition of the object area array and the dimension of the object area
- * array.
+ * The definition of a tile of the object area. The loaded tiles are linked in
+ * a list. The tile stores the clock of the last access, which is used to evict
+ * the least recently used tiles.
  *****************************************************************************/
 
-static s_point _dim_space;
+typedef struct s_obj_tile s_obj_tile;
 
-s_object **_obj_area = NULL;
+struct s_obj_tile {
+
+	s_object obj[OBJ_AREA_TILE_SIZE][OBJ_AREA_TILE_SIZE];
+
+	//
+	// The index of the tile in the tile array.
+	//
+	s_point idx;
+
+	//
+	// The clock of the last access.
+	//
+	unsigned long used;
+
+	s_obj_tile *next;
+};
 
 /******************************************************************************
- * The function allocates the array for the object area.
+ * The definition of the tile array and the dimensions of the object area and
+ * the tile array. The tile array has a pointer for each tile, which is NULL if
+ * the tile is not loaded. The clock is incremented with each access of a tile,
+ * so the tile with the smallest clock value is the least recently used. Only
+ * obj_area_get() touches the clock, obj_area_peek() is read only.
  *****************************************************************************/
 
-static s_object** obj_area_alloc(const s_point *dim) {
+static s_point _obj_area_dim;
 
-	log_debug("Creating object area with: %d/%d", dim->row, dim->col);
+static s_point _obj_area_dim_tiles;
+
+static s_obj_tile **_obj_area_tiles = NULL;
+
+static s_obj_tile *_obj_area_loaded = NULL;
+
+static int _obj_area_loaded_num = 0;
+
+static unsigned long _obj_area_clock = 0;
+
+#define obj_area_tile_idx(r,c) ((r) * _obj_area_dim_tiles.col + (c))
+
+/******************************************************************************
+ * The definition of a list of objects, which grows on demand.
+ *****************************************************************************/
 
-	s_object **obj_area = xmalloc(sizeof(s_object*) * dim->row);
+#define OBJ_LIST_INIT 64
 
-	for (int row = 0; row < dim->row; row++) {
-		obj_area[row] = xmalloc(sizeof(s_object) * dim->col);
+typedef struct {
+
+	s_object **objs;
+
+	int num;
+
+	int max;
+
+} s_obj_list;
+
+/******************************************************************************
+ * The definition of the list of damaged objects. An object is added to the
+ * list, if it changed and has to be printed again. Each object is at most once
+ * in the list.
+ *****************************************************************************/
+
+static s_obj_list _damage_list;
+
+/******************************************************************************
+ * The definition of the list of objects with a marker. Removing the markers
+ * iterates only over this list, so the cost does not depend on the size of
+ * the object area.
+ *****************************************************************************/
+
+static s_obj_list _marker_list;
+
+/******************************************************************************
+ * The function allocates an empty list of objects.
+ *****************************************************************************/
+
+static void obj_list_init(s_obj_list *list) {
+
+	list->objs = xmalloc(sizeof(s_object*) * OBJ_LIST_INIT);
+	list->max = OBJ_LIST_INIT;
+	list->num = 0;
+}
+
+/******************************************************************************
+ * The function frees a list of objects.
+ *****************************************************************************/
+
+static void obj_list_free(s_obj_list *list) {
+
+	free(list->objs);
+	list->objs = NULL;
+	list->max = 0;
+	list->num = 0;
+}
+
+/******************************************************************************
+ * The function adds an object to the list. The list grows if necessary.
+ *****************************************************************************/
+
+static void obj_list_add(s_obj_list *list, s_object *obj) {
+
+	if (list->num == list->max) {
+		list->max *= 2;
+		list->objs = realloc(list->objs, sizeof(s_object*) * list->max);
+
+		if (list->objs == NULL) {
+			log_exit("Unable to grow the list to: %d", list->max);
+		}
 	}
 
-	return obj_area;
+	list->objs[list->num++] = obj;
 }
 
 /******************************************************************************
- * The function frees the object area array.
+ * The function initializes the object area. No tiles are loaded, so the
+ * initialization does not depend on the size of the object area.
+ *****************************************************************************/
+
+void obj_area_init(const s_point *dim_hex) {
+
+	log_debug("Init object area with: %d/%d", dim_hex->row, dim_hex->col);
+
+	//
+	// Store the dimensions
+	//
+	s_point_set(&_obj_area_dim, dim_hex->row, dim_hex->col);
+
+	s_point_set(&_obj_area_dim_tiles, (dim_hex->row + OBJ_AREA_TILE_SIZE - 1) / OBJ_AREA_TILE_SIZE, (dim_hex->col + OBJ_AREA_TILE_SIZE - 1) / OBJ_AREA_TILE_SIZE);
+
+	//
+	// Allocate the tile array, without tiles.
+	//
+	const int num = _obj_area_dim_tiles.row * _obj_area_dim_tiles.col;
+
+	_obj_area_tiles = xmalloc(sizeof(s_obj_tile*) * num);
+
+	for (int i = 0; i < num; i++) {
+		_obj_area_tiles[i] = NULL;
+	}
+
+	_obj_area_loaded = NULL;
+	_obj_area_loaded_num = 0;
+	_obj_area_clock = 0;
+
+	//
+	// Allocate the lists of damaged objects and objects with markers.
+	//
+	obj_list_init(&_damage_list);
+	obj_list_init(&_marker_list);
+}
+
+/******************************************************************************
+ * The function frees the object area with the loaded tiles.
  *****************************************************************************/
 
 void obj_area_free() {
 	log_debug_str("Freeing the object area!");
 
-	for (int row = 0; row < _dim_space.row; row++) {
-		free(_obj_area[row]);
+	while (_obj_area_loaded != NULL) {
+		s_obj_tile *tile = _obj_area_loaded;
+		_obj_area_loaded = tile->next;
+		free(tile);
 	}
 
-	free(_obj_area);
-	_obj_area = NULL;
+	_obj_area_loaded_num = 0;
+
+	free(_obj_area_tiles);
+	_obj_area_tiles = NULL;
+
+	obj_list_free(&_damage_list);
+	obj_list_free(&_marker_list);
 }
 
 /******************************************************************************
- * The function initializes the object area with empty objects.
+ * The function loads a tile, which means that it is allocated and initialized
+ * with empty objects.
  *****************************************************************************/
 
-static void obj_area_init_empty(s_object **obj_area) {
-	s_point idx, neighbour;
-	s_object *object;
+static s_obj_tile* obj_area_tile_load(const int tile_row, const int tile_col) {
+
+	trace_event(TRACE_DEBUG, TRACE_AREA, "Loading tile: %ld/%ld", tile_row, tile_col);
+
+	s_obj_tile *tile = xmalloc_aligned(sizeof(s_obj_tile));
 
-	for (idx.row = 0; idx.row < _dim_space.row; idx.row++) {
-		for (idx.col = 0; idx.col < _dim_space.col; idx.col++) {
+	s_point_set(&tile->idx, tile_row, tile_col);
 
-			object = &obj_area[idx.row][idx.col];
+	for (int row = 0; row < OBJ_AREA_TILE_SIZE; row++) {
+		for (int col = 0; col < OBJ_AREA_TILE_SIZE; col++) {
 
-			s_point_set(&object->pos, idx.row, idx.col);
+			s_object *object = &tile->obj[row][col];
+
+			s_point_set(&object->pos, tile_row * OBJ_AREA_TILE_SIZE + row, tile_col * OBJ_AREA_TILE_SIZE + col);
 
 			//
 			// The object type is none
 			//
 			object->obj = OBJ_NONE;
 			object->marker = NULL;
-
-			//
-			// Iterate over the directions to find the neighbours.
-			//
-			for (int dir = 0; dir < 6; dir++) {
-
-				//
-				// Get the coordinates of the neighbour in that direction.
-				//
-				obj_area_goto(&idx, dir, &neighbour);
-
-				//
-				// Ensure that the neighbour coordinates are valid.
-				//
-				if (s_point_inside(&_dim_space, &neighbour)) {
-					object->neighbour[dir] = &obj_area[neighbour.row][neighbour.col];
-				} else {
-					object->neighbour[dir] = NULL;
-				}
-			}
+			object->damaged = false;
 		}
 	}
+
+	//
+	// Add the tile to the tile array and the list of loaded tiles.
+	//
+	_obj_area_tiles[obj_area_tile_idx(tile_row, tile_col)] = tile;
+
+	tile->next = _obj_area_loaded;
+	_obj_area_loaded = tile;
+	_obj_area_loaded_num++;
+
+	return tile;
 }
 
 /******************************************************************************
- * The function initializes the object area.
+ * The function returns the object with the given index. If the tile of the
+ * object is not loaded, it is loaded.
  *****************************************************************************/
 
-void obj_area_init(const s_point *dim_hex) {
+s_object* obj_area_get(const int row, const int col) {
+
+#ifdef DEBUG
+	const s_point idx = { .row = row, .col = col };
+
+	if (!s_point_inside(&_obj_area_dim, &idx)) {
+		log_exit("Index out of range: %d/%d", row, col);
+	}
+#endif
+
+	const int tile_row = row / OBJ_AREA_TILE_SIZE;
+	const int tile_col = col / OBJ_AREA_TILE_SIZE;
+
+	s_obj_tile *tile = _obj_area_tiles[obj_area_tile_idx(tile_row, tile_col)];
+
+	if (tile == NULL) {
+		tile = obj_area_tile_load(tile_row, tile_col);
+	}
 
-	log_debug_str("Init object area.");
+	tile->used = ++_obj_area_clock;
+
+	return &tile->obj[row % OBJ_AREA_TILE_SIZE][col % OBJ_AREA_TILE_SIZE];
+}
+
+/******************************************************************************
+ * The function returns the object with the given index, if its tile is loaded.
+ * Otherwise the object is empty and the function returns NULL without loading
+ * the tile. This is used for read only access, like the rendering, so the
+ * clock of the tile is not touched.
+ *****************************************************************************/
+
+s_object* obj_area_peek(const int row, const int col) {
+
+#ifdef DEBUG
+	const s_point idx = { .row = row, .col = col };
+
+	if (!s_point_inside(&_obj_area_dim, &idx)) {
+		log_exit("Index out of range: %d/%d", row, col);
+	}
+#endif
+
+	const s_obj_tile *tile = _obj_area_tiles[obj_area_tile_idx(row / OBJ_AREA_TILE_SIZE, col / OBJ_AREA_TILE_SIZE)];
+
+	if (tile == NULL) {
+		return NULL;
+	}
+
+	return (s_object*) &tile->obj[row % OBJ_AREA_TILE_SIZE][col % OBJ_AREA_TILE_SIZE];
+}
+
+/******************************************************************************
+ * The table with the offsets of the neighbours in each direction. The odd
+ * columns are shifted down by half a hex field, so the offset depends only on
+ * the parity of the column, which is the first index of the table.
+ *****************************************************************************/
+
+const s_point _obj_area_adj[2][DIR_NUM] = {
 
 	//
-	// Store the dimensions
+	// Even columns
 	//
-	s_point_set(&_dim_space, dim_hex->row, dim_hex->col);
+	{ { -1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 0 }, { 0, -1 }, { -1, -1 } },
 
 	//
-	// Allocate the array
+	// Odd columns
 	//
-	_obj_area = obj_area_alloc(dim_hex);
+	{ { -1, 0 }, { 0, 1 }, { 1, 1 }, { 1, 0 }, { 1, -1 }, { 0, -1 } }
+};
+
+/******************************************************************************
+ * The function computes the index of the adjacent hex field in the given
+ * direction. It returns false if the adjacent hex field is outside the object
+ * area.
+ *****************************************************************************/
+
+bool obj_area_adjacent(const s_point *from, const e_dir dir, s_point *to) {
+
+	obj_area_goto(from, dir, to);
+
+	return s_point_inside(&_obj_area_dim, to);
+}
+
+/******************************************************************************
+ * The function returns the neighbour of an object in the given direction or
+ * NULL if the neighbour is outside the object area.
+ *****************************************************************************/
+
+s_object* obj_area_neighbour(const s_object *obj, const e_dir dir) {
+	s_point neighbour;
+
+	if (!obj_area_adjacent(&obj->pos, dir, &neighbour)) {
+		return NULL;
+	}
+
+	return obj_area_get(neighbour.row, neighbour.col);
+}
+
+/******************************************************************************
+ * The function checks if a tile is empty, which means that it can be evicted
+ * and loaded again without losing anything.
+ *****************************************************************************/
+
+static bool obj_area_tile_is_empty(const s_obj_tile *tile) {
+
+	for (int row = 0; row < OBJ_AREA_TILE_SIZE; row++) {
+		for (int col = 0; col < OBJ_AREA_TILE_SIZE; col++) {
+
+			const s_object *object = &tile->obj[row][col];
+
+			if (object->obj != OBJ_NONE || object->marker != NULL || object->damaged) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/******************************************************************************
+ * The function evicts the least recently used tiles, if more than
+ * OBJ_AREA_TILES_MAX tiles are loaded. Only empty tiles, that are not near the
+ * area given by the position and the dimension (the viewport), are evicted.
+ * The function is called once per frame, when no pointers to objects of an
+ * empty tile outside the viewport are used.
+ *****************************************************************************/
+
+void obj_area_evict(const s_point *pos, const s_point *dim) {
 
 	//
-	// Initialize the object area with empty objects.
+	// The tiles of the area including a margin of one tile.
 	//
-	obj_area_init_empty(_obj_area);
+	const int row_min = pos->row / OBJ_AREA_TILE_SIZE - 1;
+	const int col_min = pos->col / OBJ_AREA_TILE_SIZE - 1;
+	const int row_max = (pos->row + dim->row - 1) / OBJ_AREA_TILE_SIZE + 1;
+	const int col_max = (pos->col + dim->col - 1) / OBJ_AREA_TILE_SIZE + 1;
+
+	while (_obj_area_loaded_num > OBJ_AREA_TILES_MAX) {
+		s_obj_tile **lru = NULL;
+
+		for (s_obj_tile **ptr = &_obj_area_loaded; *ptr != NULL; ptr = &(*ptr)->next) {
+			const s_obj_tile *tile = *ptr;
+
+			if (row_min <= tile->idx.row && tile->idx.row <= row_max && col_min <= tile->idx.col && tile->idx.col <= col_max) {
+				continue;
+			}
+
+			if ((lru == NULL || tile->used < (*lru)->used) && obj_area_tile_is_empty(tile)) {
+				lru = ptr;
+			}
+		}
+
+		//
+		// All tiles are in use.
+		//
+		if (lru == NULL) {
+			trace_event(TRACE_WARN, TRACE_AREA, "Unable to evict tiles, loaded: %ld", _obj_area_loaded_num);
+			return;
+		}
+
+		s_obj_tile *tile = *lru;
+
+		trace_event(TRACE_DEBUG, TRACE_AREA, "Evicting tile: %ld/%ld", tile->idx.row, tile->idx.col);
+
+		*lru = tile->next;
+		_obj_area_loaded_num--;
+
+		_obj_area_tiles[obj_area_tile_idx(tile->idx.row, tile->idx.col)] = NULL;
+		free(tile);
+	}
+}
+
+/******************************************************************************
+ * The function returns the number of loaded tiles.
+ *****************************************************************************/
+
+int obj_area_tiles_num() {
+	return _obj_area_loaded_num;
+}
+
+/******************************************************************************
+ * The function sets the marker of an object and registers the object, so the
+ * marker can be removed without searching the object area.
+ *****************************************************************************/
+
+void obj_area_add_marker(s_object *obj, s_marker *marker) {
+
+	if (obj->marker == NULL) {
+		obj_list_add(&_marker_list, obj);
+	}
+
+	obj->marker = marker;
 }
 
 /******************************************************************************
- * The function is called with a current position and a direction. It updates
- * the target point to the adjacent field in the given direction.
+ * The function removes all markers from the object area. The objects with a
+ * marker are damaged.
  *****************************************************************************/
 
-void obj_area_goto(const s_point *from, const e_dir dir, s_point *to) {
+void obj_area_rm_markers() {
 
-	switch (dir) {
+	trace_event(TRACE_DEBUG, TRACE_AREA, "Removing markers: %ld", _marker_list.num);
 
-	case DIR_NN:
-		to->row = from->row - 1;
-		to->col = from->col;
-		break;
+	for (int i = 0; i < _marker_list.num; i++) {
+		s_object *object = _marker_list.objs[i];
 
-	case DIR_NE:
-		to->row = from->row % 2 == 0 ? from->row - 1 + from->col % 2 : from->row - 1 + from->col % 2;
-		to->col = from->col + 1;
-		break;
+		object->marker = NULL;
+		obj_area_damage(object);
+	}
 
-	case DIR_SE:
-		to->row = from->row % 2 == 0 ? from->row + from->col % 2 : from->row + from->col % 2;
-		to->col = from->col + 1;
-		break;
+	_marker_list.num = 0;
+}
 
-	case DIR_SS:
-		to->row = from->row + 1;
-		to->col = from->col;
-		break;
+/******************************************************************************
+ * The function computes the adjacent fields in all 6 directions. The array of
+ * the target points is indexed by the direction.
+ *****************************************************************************/
 
-	case DIR_SW:
-		to->row = from->row % 2 == 0 ? from->row + from->col % 2 : from->row + from->col % 2;
-		to->col = from->col - 1;
-		break;
+void obj_area_goto_all(const s_point *from, s_point to[DIR_NUM]) {
 
-	case DIR_NW:
-		to->row = from->row % 2 == 0 ? from->row - 1 + from->col % 2 : from->row - 1 + from->col % 2;
-		to->col = from->col - 1;
-		break;
+	const s_point *offset = _obj_area_adj[from->col & 1];
 
-	default:
-		log_exit("Unknown direction: %d", dir)
-		;
+	for (int dir = 0; dir < DIR_NUM; dir++) {
+		to[dir].row = from->row + offset[dir].row;
+		to[dir].col = from->col + offset[dir].col;
 	}
 }
 
@@ -237,6 +537,11 @@ void obj_area_mv_ship(s_object *obj_from, s_object *obj_to, const e_dir dir) {
 		log_exit("Target is not empty: %d/%d", obj_to->pos.row, obj_to->pos.col);
 	}
 
+	//
+	// Ensure that the ship instance was not released.
+	//
+	s_ship_inst_check(obj_from->ship_inst);
+
 	//
 	// Copy the ship instance to the target.
 	//
@@ -253,6 +558,12 @@ void obj_area_mv_ship(s_object *obj_from, s_object *obj_to, const e_dir dir) {
 	//
 	obj_from->obj = OBJ_NONE;
 	obj_from->ship_inst = NULL;
+
+	//
+	// Both objects changed.
+	//
+	obj_area_damage(obj_from);
+	obj_area_damage(obj_to);
 }
 
 /******************************************************************************
@@ -290,7 +601,9 @@ s_object* obj_area_set_mv_marker(s_object *obj, const e_dir dir) {
 	//
 	// If the target is not null, we can set the move marker.
 	//
-	obj->marker = s_marker_get_move_marker(MRK_TYPE_MOVE, dir);
+	obj_area_add_marker(obj, s_marker_get_move_marker(MRK_TYPE_MOVE, dir));
+
+	obj_area_damage(obj);
 
 	//
 	// Return the result object from the area.
@@ -335,13 +648,13 @@ s_object* obj_area_set_mv_marker_path(s_object *obj_from, const char *mv_path) {
 		//
 		// Go to the neighbor in that direction.
 		//
-		obj_to = obj_to->neighbour[dir];
+		obj_to = obj_area_neighbour(obj_to, dir);
 
 		//
 		// If the pointer is null, we are outside the object area.
 		//
 		if (obj_to == NULL) {
-			log_debug_str("Object to is null!");
+			trace_event_str(TRACE_DEBUG, TRACE_AREA, "Object to is null!");
 			return NULL;
 		}
 	}
@@ -351,7 +664,7 @@ s_object* obj_area_set_mv_marker_path(s_object *obj_from, const char *mv_path) {
 	// it is occupied.
 	//
 	if (obj_to->obj != OBJ_NONE) {
-		log_debug("Target is occupied: %d/%d", obj_to->pos.row, obj_to->pos.col);
+		trace_event(TRACE_DEBUG, TRACE_AREA, "Target is occupied: %ld/%ld", obj_to->pos.row, obj_to->pos.col);
 		return NULL;
 	}
 
@@ -360,3 +673,101 @@ s_object* obj_area_set_mv_marker_path(s_object *obj_from, const char *mv_path) {
 	//
 	return obj_area_set_mv_marker(obj_to, dir);
 }
+
+/******************************************************************************
+ * The function walks the children of a node of the path trie recursively. The
+ * object is the position of the node. A marker is set at a child, if a path
+ * ends there and the object is empty. If a child is outside the object area,
+ * all paths through that child end outside, so the subtree is skipped.
+ *****************************************************************************/
+
+static void obj_area_set_mv_marker_node(const s_path_node *trie, const int idx, s_object *obj, const e_dir dir_start) {
+
+	for (int turn = 0; turn < PATH_TURN_NUM; turn++) {
+
+		const int child = trie[idx].child[turn];
+
+		if (child == 0) {
+			continue;
+		}
+
+		const e_dir dir = trie[child].dir[dir_start];
+
+		s_object *obj_to = obj_area_neighbour(obj, dir);
+
+		if (obj_to == NULL) {
+			continue;
+		}
+
+		if (trie[child].end && obj_to->obj == OBJ_NONE) {
+			obj_area_set_mv_marker(obj_to, dir);
+		}
+
+		obj_area_set_mv_marker_node(trie, child, obj_to, dir_start);
+	}
+}
+
+/******************************************************************************
+ * The function sets the move markers for all paths of a ship. The paths are
+ * compiled to a trie, so common prefixes of the paths are walked only once.
+ * The result is the same as calling obj_area_set_mv_marker_path() for each
+ * path.
+ *****************************************************************************/
+
+void obj_area_set_mv_markers(s_object *obj_from) {
+
+	//
+	// It is necessary that the object area has a ship at the initial position.
+	//
+	if (obj_from->obj != OBJ_SHIP) {
+		log_exit_str("Object is not a ship!");
+	}
+
+	const s_ship_inst *ship_inst = obj_from->ship_inst;
+
+	obj_area_set_mv_marker_node(ship_inst->ship_type->path_trie, 0, obj_from, ship_inst->dir);
+}
+
+/******************************************************************************
+ * The function marks an object as damaged, which means that it has to be
+ * printed again. An object that is already damaged is not added twice.
+ *****************************************************************************/
+
+void obj_area_damage(s_object *obj) {
+
+	if (obj->damaged) {
+		return;
+	}
+
+	obj->damaged = true;
+	obj_list_add(&_damage_list, obj);
+}
+
+/******************************************************************************
+ * The function removes the next damaged object from the list and returns it.
+ * If there are no damaged objects, the function returns NULL.
+ *****************************************************************************/
+
+s_object* obj_area_damage_next() {
+
+	if (_damage_list.num == 0) {
+		return NULL;
+	}
+
+	s_object *obj = _damage_list.objs[--_damage_list.num];
+	obj->damaged = false;
+
+	return obj;
+}
+
+/******************************************************************************
+ * The function resets the list of damaged objects. This is used after the
+ * whole viewport was printed.
+ *****************************************************************************/
+
+void obj_area_damage_reset() {
+
+	while (_damage_list.num > 0) {
+		_damage_list.objs[--_damage_list.num]->damaged = false;
+	}
+}
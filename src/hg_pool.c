@@ -0,0 +1,231 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+
+#include "hg_pool.h"
+#include "hg_trace.h"
+
+/******************************************************************************
+ * The header of a slot, which is followed by the element. The size of the
+ * header is rounded up, so the element has the maximal alignment.
+ *****************************************************************************/
+
+typedef struct {
+
+	int idx;
+
+	int next;
+
+	unsigned int gen;
+
+} s_pool_slot;
+
+#define pool_align(s) (((s) + _Alignof(max_align_t) - 1) / _Alignof(max_align_t) * _Alignof(max_align_t))
+
+#define POOL_HEADER pool_align(sizeof(s_pool_slot))
+
+#define pool_slot(p,i) ((s_pool_slot*) ((p)->chunks[(i) / (p)->chunk_slots] + (size_t) ((i) % (p)->chunk_slots) * (p)->slot_size))
+
+#define pool_slot_of(e) ((s_pool_slot*) ((char*) (e) - POOL_HEADER))
+
+#define pool_slot_elem(s) ((void*) ((char*) (s) + POOL_HEADER))
+
+#define pool_gen_live(g) ((g) & 1)
+
+/******************************************************************************
+ * The function initializes an empty pool. No chunk is allocated.
+ *****************************************************************************/
+
+void pool_init(s_pool *pool, const char *name, const size_t elem_size, const int chunk_slots) {
+
+	log_debug("Init pool: %s elem size: %zu chunk: %d", name, elem_size, chunk_slots);
+
+	pool->name = name;
+	pool->elem_size = elem_size;
+	pool->slot_size = POOL_HEADER + pool_align(elem_size);
+
+	pool->chunks = NULL;
+	pool->chunk_slots = chunk_slots;
+	pool->chunk_num = 0;
+	pool->chunk_max = 0;
+
+	pool->slot_num = 0;
+	pool->free = -1;
+	pool->used = 0;
+}
+
+/******************************************************************************
+ * The function frees the chunks of the pool. All elements are invalid
+ * afterwards.
+ *****************************************************************************/
+
+void pool_free(s_pool *pool) {
+
+	log_debug("Free pool: %s chunks: %d used: %d", pool->name, pool->chunk_num, pool->used);
+
+	for (int i = 0; i < pool->chunk_num; i++) {
+		free(pool->chunks[i]);
+	}
+
+	free(pool->chunks);
+
+	pool_init(pool, pool->name, pool->elem_size, pool->chunk_slots);
+}
+
+/******************************************************************************
+ * The function adds a chunk to the pool.
+ *****************************************************************************/
+
+static void pool_grow(s_pool *pool) {
+
+	trace_event(TRACE_DEBUG, TRACE_AREA, "Pool grows to chunks: %ld", (long) pool->chunk_num + 1);
+
+	if (pool->chunk_num == pool->chunk_max) {
+		pool->chunk_max = pool->chunk_max == 0 ? 4 : pool->chunk_max * 2;
+		pool->chunks = realloc(pool->chunks, sizeof(char*) * pool->chunk_max);
+
+		if (pool->chunks == NULL) {
+			log_exit("Unable to grow the chunks of pool: %s", pool->name);
+		}
+	}
+
+	pool->chunks[pool->chunk_num++] = xmalloc_aligned(pool->slot_size * pool->chunk_slots);
+}
+
+/******************************************************************************
+ * The function allocates an element. A released element is reused if
+ * possible, otherwise the next unused slot is taken. If all chunks are
+ * used, a new chunk is added.
+ *****************************************************************************/
+
+void* pool_alloc(s_pool *pool) {
+	s_pool_slot *slot;
+
+	if (pool->free >= 0) {
+		slot = pool_slot(pool, pool->free);
+		pool->free = slot->next;
+
+	} else {
+
+		if (pool->slot_num == pool->chunk_num * pool->chunk_slots) {
+			pool_grow(pool);
+		}
+
+		slot = pool_slot(pool, pool->slot_num);
+		slot->idx = pool->slot_num++;
+		slot->gen = 0;
+	}
+
+	slot->gen++;
+	slot->next = -1;
+	pool->used++;
+
+	return pool_slot_elem(slot);
+}
+
+/******************************************************************************
+ * The function releases an element and adds it to the free list.
+ *****************************************************************************/
+
+void pool_release(s_pool *pool, void *elem) {
+
+	s_pool_slot *slot = pool_slot_of(elem);
+
+	if (!pool_gen_live(slot->gen)) {
+		log_exit("Element of pool: %s released twice: %d", pool->name, slot->idx);
+	}
+
+	slot->gen++;
+	slot->next = pool->free;
+	pool->free = slot->idx;
+	pool->used--;
+}
+
+/******************************************************************************
+ * The function releases all elements in use. This is cheaper than releasing
+ * the elements one by one, if all elements have the same life cycle.
+ *****************************************************************************/
+
+void pool_release_all(s_pool *pool) {
+
+	for (int i = pool->slot_num - 1; i >= 0; i--) {
+		s_pool_slot *slot = pool_slot(pool, i);
+
+		if (pool_gen_live(slot->gen)) {
+			slot->gen++;
+		}
+
+		slot->next = i + 1 < pool->slot_num ? i + 1 : -1;
+	}
+
+	pool->free = pool->slot_num > 0 ? 0 : -1;
+	pool->used = 0;
+}
+
+/******************************************************************************
+ * The function returns the handle of an element.
+ *****************************************************************************/
+
+s_pool_hdl pool_hdl(const s_pool *pool, const void *elem) {
+
+	const s_pool_slot *slot = pool_slot_of(elem);
+
+	if (!pool_gen_live(slot->gen)) {
+		log_exit("Element of pool: %s is not in use: %d", pool->name, slot->idx);
+	}
+
+	return (s_pool_hdl) { .idx = slot->idx, .gen = slot->gen };
+}
+
+/******************************************************************************
+ * The function returns the element of a handle or NULL if the handle is stale,
+ * which means that the element was released.
+ *****************************************************************************/
+
+void* pool_get(const s_pool *pool, const s_pool_hdl hdl) {
+
+	if (hdl.idx < 0 || hdl.idx >= pool->slot_num) {
+		return NULL;
+	}
+
+	s_pool_slot *slot = pool_slot(pool, hdl.idx);
+
+	if (slot->gen != hdl.gen) {
+		return NULL;
+	}
+
+	return pool_slot_elem(slot);
+}
+
+/******************************************************************************
+ * The function checks if an element is in use.
+ *****************************************************************************/
+
+bool pool_is_live(const s_pool *pool, const void *elem) {
+
+	const s_pool_slot *slot = pool_slot_of(elem);
+
+	return slot->idx >= 0 && slot->idx < pool->slot_num && pool_slot(pool, slot->idx) == slot && pool_gen_live(slot->gen);
+}
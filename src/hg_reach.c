@@ -0,0 +1,265 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "hg_reach.h"
+#include "hg_trace.h"
+
+/******************************************************************************
+ * The path characters of the turns, which are the characters of e_dir_mv().
+ *****************************************************************************/
+
+static const char _reach_turn_chr[PATH_TURN_NUM] = { 'l', 'c', 'r' };
+
+//
+// The direction after a turn (0: left, 1: center, 2: right).
+//
+#define reach_turn(d,t) (((d) + (t) + DIR_NUM - 1) % DIR_NUM)
+
+/******************************************************************************
+ * The macros for the bitsets of the states.
+ *****************************************************************************/
+
+#define bitset_words(n) (((n) + 63) / 64)
+
+#define bitset_set(b,i) ((b)[(i) / 64] |= (uint64_t) 1 << ((i) % 64))
+
+#define bitset_test(b,i) (((b)[(i) / 64] >> ((i) % 64)) & 1)
+
+/******************************************************************************
+ * An entry of the bucket queue. The buckets are linked lists of entries, one
+ * for each cost. A state can be added more than once with decreasing costs,
+ * the entries of settled states are skipped.
+ *****************************************************************************/
+
+typedef struct {
+
+	int state;
+
+	int next;
+
+} s_reach_entry;
+
+/******************************************************************************
+ * The function computes the reachable states with Dijkstra's algorithm. The
+ * costs are small integers, so the priority queue is an array of buckets, one
+ * for each cost (Dial's algorithm), which are processed in order.
+ *
+ * A ship with n movement points moves at most n hex fields in each
+ * direction, so the states are indexed in a window of (2n + 1) x (2n + 1)
+ * hex fields around the start. The memory does not depend on the size of the
+ * object area. It is allocated from the arena, so the result is valid until
+ * the arena is reset.
+ *
+ * The window and the buckets require that the movement points are not
+ * negative and that each step costs at least 1 point, otherwise the program
+ * terminates.
+ *****************************************************************************/
+
+void reach_compute(s_arena *arena, const s_ship_move *move, const s_point *start, const e_dir dir, s_reach *reach) {
+	s_point to;
+
+	if (move->points < 0) {
+		log_exit("Invalid movement points: %d", move->points);
+	}
+
+	for (int t = 0; t < PATH_TURN_NUM; t++) {
+		if (move->cost[t] < 1) {
+			log_exit("Invalid cost: %d of turn: %d", move->cost[t], t);
+		}
+	}
+
+	const int points = move->points;
+	const int win = 2 * points + 1;
+	const int state_num = win * win * DIR_NUM;
+
+	const s_point origin = { .row = start->row - points, .col = start->col - points };
+
+	//
+	// The bitsets for the states, that were added (with a cost) and that are
+	// settled (with the cheapest cost).
+	//
+	const size_t words = bitset_words(state_num) * sizeof(uint64_t);
+
+	uint64_t *seen = arena_alloc(arena, words);
+	uint64_t *settled = arena_alloc(arena, words);
+
+	memset(seen, 0, words);
+	memset(settled, 0, words);
+
+	//
+	// The cost, the previous state and the turn of the states, which are
+	// only valid for the states that were seen.
+	//
+	short *cost = arena_alloc(arena, sizeof(short) * state_num);
+	int *parent = arena_alloc(arena, sizeof(int) * state_num);
+	short *turn = arena_alloc(arena, sizeof(short) * state_num);
+
+	//
+	// Each settled state adds at most one entry per turn.
+	//
+	int *bucket = arena_alloc(arena, sizeof(int) * (points + 1));
+	s_reach_entry *entries = arena_alloc(arena, sizeof(s_reach_entry) * (state_num * PATH_TURN_NUM + 1));
+	int entry_num = 0;
+
+	for (int i = 0; i <= points; i++) {
+		bucket[i] = -1;
+	}
+
+	reach->states = arena_alloc(arena, sizeof(s_reach_state) * state_num);
+	reach->num = 0;
+
+	//
+	// Add the start state.
+	//
+	const int state_start = (points * win + points) * DIR_NUM + dir;
+
+	bitset_set(seen, state_start);
+	cost[state_start] = 0;
+	parent[state_start] = -1;
+	turn[state_start] = -1;
+
+	entries[entry_num] = (s_reach_entry) { .state = state_start, .next = -1 };
+	bucket[0] = entry_num++;
+
+	for (int c = 0; c <= points; c++) {
+
+		while (bucket[c] != -1) {
+
+			const s_reach_entry *entry = &entries[bucket[c]];
+			bucket[c] = entry->next;
+
+			const int state = entry->state;
+
+			if (bitset_test(settled, state)) {
+				continue;
+			}
+
+			bitset_set(settled, state);
+
+			//
+			// The state is settled with the cheapest cost, so it is a result.
+			//
+			const int cell = state / DIR_NUM;
+			const e_dir state_dir = state % DIR_NUM;
+
+			s_reach_state *result = &reach->states[reach->num];
+
+			s_point_set(&result->pos, origin.row + cell / win, origin.col + cell % win);
+			result->dir = state_dir;
+			result->cost = c;
+			result->turn = turn[state];
+			result->parent = parent[state];
+
+			const int idx = reach->num++;
+
+			//
+			// Relax the steps with the 3 turns.
+			//
+			for (int t = 0; t < PATH_TURN_NUM; t++) {
+
+				const int c_next = c + move->cost[t];
+
+				if (c_next > points) {
+					continue;
+				}
+
+				const e_dir dir_next = reach_turn(state_dir, t);
+
+				if (!obj_area_adjacent(&result->pos, dir_next, &to)) {
+					continue;
+				}
+
+				//
+				// A tile that is not loaded is empty.
+				//
+				const s_object *obj = obj_area_peek(to.row, to.col);
+
+				if (obj != NULL && obj->obj != OBJ_NONE) {
+					continue;
+				}
+
+				const int next = ((to.row - origin.row) * win + (to.col - origin.col)) * DIR_NUM + dir_next;
+
+				if (bitset_test(settled, next) || (bitset_test(seen, next) && cost[next] <= c_next)) {
+					continue;
+				}
+
+				bitset_set(seen, next);
+				cost[next] = c_next;
+				parent[next] = idx;
+				turn[next] = t;
+
+				entries[entry_num] = (s_reach_entry) { .state = next, .next = bucket[c_next] };
+				bucket[c_next] = entry_num++;
+			}
+		}
+	}
+
+	trace_event(TRACE_DEBUG, TRACE_AREA, "Reachable states: %ld entries: %ld", reach->num, entry_num);
+}
+
+/******************************************************************************
+ * The function computes the reachable states of a ship, with the movement of
+ * its ship type.
+ *****************************************************************************/
+
+void reach_ship(s_arena *arena, const s_object *obj, s_reach *reach) {
+
+	if (obj->obj != OBJ_SHIP) {
+		log_exit("Object is not a ship: %d/%d", obj->pos.row, obj->pos.col);
+	}
+
+	reach_compute(arena, &obj->ship_inst->ship_type->move, &obj->pos, obj->ship_inst->dir, reach);
+}
+
+/******************************************************************************
+ * The function writes the cheapest path to a state as a path string, which
+ * can be used with obj_area_set_mv_marker_path(). The function returns the
+ * length of the path.
+ *****************************************************************************/
+
+int reach_path(const s_reach *reach, const int idx, char *path, const int size) {
+	int len = 0;
+
+	for (int i = idx; reach->states[i].parent != -1; i = reach->states[i].parent) {
+		len++;
+	}
+
+	if (len >= size) {
+		log_exit("Path too long: %d size: %d", len, size);
+	}
+
+	path[len] = '\0';
+
+	int pos = len;
+
+	for (int i = idx; reach->states[i].parent != -1; i = reach->states[i].parent) {
+		path[--pos] = _reach_turn_chr[reach->states[i].turn];
+	}
+
+	return len;
+}
@@ -0,0 +1,342 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "hg_render.h"
+#include "hg_space.h"
+#include "hg_ship.h"
+#include "hg_hex.h"
+#include "hg_metrics.h"
+#include "hg_trace.h"
+
+/******************************************************************************
+ * The cache of the composed hex images. The image of an object depends on the
+ * shading, the highlighting, the marker and the ship of the object. The stars
+ * are a separate layer, which is added when the image is printed, so the
+ * cache is small and the images are composed only once.
+ *
+ * The index of the marker is 0 for no marker, 1 for a move marker without a
+ * direction and 2 + direction for a move marker with a direction. The index of
+ * the ship is 0 for no ship and 1 + ship type * 6 + direction for a ship.
+ *****************************************************************************/
+
+#define CACHE_SHADES 3
+
+#define CACHE_MARKERS (DIR_NUM + 2)
+
+#define CACHE_SHIPS (SHIP_TYPE_NUM * DIR_NUM + 1)
+
+typedef struct {
+
+	bool valid;
+
+	s_hex_image image;
+
+} s_cache_entry;
+
+static s_cache_entry _cache[CACHE_SHADES][2][CACHE_MARKERS][CACHE_SHIPS];
+
+/******************************************************************************
+ * The function returns the object with the given index for the rendering,
+ * without loading its tile. The objects of a tile that is not loaded are
+ * empty, so an empty object with the index is returned instead.
+ *****************************************************************************/
+
+static s_object _render_empty = { .obj = OBJ_NONE, .marker = NULL, .damaged = false };
+
+static const s_object* render_peek(const s_point *idx) {
+
+	const s_object *obj = obj_area_peek(idx->row, idx->col);
+
+	if (obj != NULL) {
+		return obj;
+	}
+
+	s_point_copy(&_render_empty.pos, idx);
+
+	return &_render_empty;
+}
+
+/******************************************************************************
+ * The function invalidates all images of the cache. The images contain color
+ * pairs, so the cache has to be reset, if the color pairs are reset.
+ *****************************************************************************/
+
+void render_cache_reset() {
+
+	trace_event_str(TRACE_INFO, TRACE_RENDER, "Reset the image cache");
+
+	memset(_cache, 0, sizeof(_cache));
+}
+
+/******************************************************************************
+ * The function returns the cache index of the marker of an object.
+ *****************************************************************************/
+
+static int render_cache_marker_idx(const s_marker *marker) {
+
+	if (marker == NULL) {
+		return 0;
+	}
+
+	switch (marker->type) {
+
+	case MRK_TYPE_MOVE:
+		return marker->marker_move->dir + 2;
+
+	default:
+		log_exit("Unknown marker type: %d", marker->type)
+		;
+	}
+}
+
+/******************************************************************************
+ * The function returns the cache index of the ship of an object.
+ *****************************************************************************/
+
+static int render_cache_ship_idx(const s_object *obj) {
+
+	switch (obj->obj) {
+
+	case OBJ_NONE:
+		return 0;
+
+	case OBJ_SHIP:
+		return 1 + obj->ship_inst->ship_type->type * DIR_NUM + obj->ship_inst->dir;
+
+	default:
+		log_exit("Unknown object type: %d", obj->obj)
+		;
+	}
+}
+
+/******************************************************************************
+ * The function composes the hex image of an object, which is the space hex
+ * field without stars, the marker and the ship, if the object has one.
+ *****************************************************************************/
+
+static void render_compose(const s_object *obj, const int color_idx, const bool highlight, s_hex_image *hex_image) {
+	s_hex_field hf_tmp_bg;
+
+	trace_event(TRACE_INFO, TRACE_RENDER, "Compose: %ld/%ld color index: %ld", obj->pos.row, obj->pos.col, color_idx);
+
+	space_get_hex_field(color_idx, highlight, &hf_tmp_bg);
+
+	s_marker_add_to_field(obj->marker, color_idx, highlight, &hf_tmp_bg);
+
+	if (obj->obj == OBJ_SHIP) {
+		hex_image_compose(hex_image, ship_get_hex_field(obj->ship_inst->ship_type, obj->ship_inst->dir), &hf_tmp_bg);
+
+	} else {
+		hex_image_compose(hex_image, NULL, &hf_tmp_bg);
+	}
+}
+
+/******************************************************************************
+ * The function prints an object to the frame. The hex image of the object is
+ * taken from the cache and composed on a miss. The stars of the space hex
+ * field are added while printing.
+ *****************************************************************************/
+
+void render_object(s_frame *frame, const s_viewport *viewport, const s_object *obj, const bool highlight) {
+
+	s_point pos_ul;
+	s_viewport_get_ul(viewport, &obj->pos, &pos_ul);
+
+	//
+	// Get the index of the shading (0, 1, 2)
+	//
+	const int color_idx = hex_field_color_idx(obj->pos.row, obj->pos.col);
+
+	s_cache_entry *entry = &_cache[color_idx][highlight][render_cache_marker_idx(obj->marker)][render_cache_ship_idx(obj)];
+
+	if (!entry->valid) {
+		render_compose(obj, color_idx, highlight, &entry->image);
+		entry->valid = true;
+
+		metrics_add(cache_misses, 1);
+	}
+
+	metrics_add(hexes, 1);
+
+	hex_image_print(frame, &pos_ul, &entry->image, space_get_stars(&obj->pos));
+}
+
+/******************************************************************************
+ * The function prints the space hex fields of the game. All objects are
+ * printed, so there are no damaged objects left afterwards.
+ *
+ * The frame is erased, the render target is not cleared. The flush of the frame
+ * writes only the cells that changed.
+ *****************************************************************************/
+
+void render_objects(s_frame *frame, const s_viewport *viewport, const s_object *cursor) {
+	trace_event_str(TRACE_DEBUG, TRACE_RENDER, "Print objects");
+
+	const s_object *obj;
+	s_point idx_rel, idx_abs;
+
+	frame_erase(frame, 0, 0, frame->dim.row, frame->dim.col);
+
+	for (idx_rel.row = 0; idx_rel.row < viewport->dim.row; idx_rel.row++) {
+		for (idx_rel.col = 0; idx_rel.col < viewport->dim.col; idx_rel.col++) {
+
+			s_viewport_get_abs(viewport, &idx_rel, &idx_abs);
+
+			obj = render_peek(&idx_abs);
+
+			render_object(frame, viewport, obj, obj == cursor);
+		}
+	}
+
+	obj_area_damage_reset();
+}
+
+/******************************************************************************
+ * The function prints the objects of a rectangle of the viewport. The
+ * rectangle is given by relative indices and is clipped to the viewport.
+ *****************************************************************************/
+
+static void render_objects_rect(s_frame *frame, const s_viewport *viewport, const s_object *cursor, const int row, const int col, const int rows, const int cols) {
+
+	const s_object *obj;
+	s_point idx_rel, idx_abs;
+
+	for (idx_rel.row = row < 0 ? 0 : row; idx_rel.row < row + rows && idx_rel.row < viewport->dim.row; idx_rel.row++) {
+		for (idx_rel.col = col < 0 ? 0 : col; idx_rel.col < col + cols && idx_rel.col < viewport->dim.col; idx_rel.col++) {
+
+			s_viewport_get_abs(viewport, &idx_rel, &idx_abs);
+
+			obj = render_peek(&idx_abs);
+
+			render_object(frame, viewport, obj, obj == cursor);
+		}
+	}
+}
+
+/******************************************************************************
+ * The function is called after the viewport moved from an old position. It
+ * shifts the content of the frame and the render target, so only the hex
+ * fields that became visible have to be printed. If the viewport moved too
+ * far, all objects are printed.
+ *
+ * The row offset of a hex field depends on the parity of its absolute column,
+ * not on the column in the viewport. So moving the viewport by one column
+ * shifts the content horizontally only.
+ *
+ * Shifting requires that the whole viewport is visible in the frame,
+ * otherwise there are clipped hex fields that have to be printed.
+ *
+ * Hex fields interlock with their neighbors. The hex fields that left the
+ * viewport leave parts on its border, so the border is erased and the outer
+ * row / column of the viewport is printed again:
+ *
+ * - viewport moves down: lower halves of hex fields in the first two lines
+ * - viewport moves up: upper halves of hex fields below the last row
+ * - viewport moves right: right columns of hex fields in the first column
+ * - viewport moves left: left columns of hex fields right of the last column
+ *****************************************************************************/
+
+void render_objects_scroll(s_frame *frame, s_target *target, const s_viewport *viewport, const s_point *pos_old, const s_object *cursor) {
+
+	const int diff_row = viewport->pos.row - pos_old->row;
+	const int diff_col = viewport->pos.col - pos_old->col;
+
+	trace_event(TRACE_DEBUG, TRACE_RENDER, "Scroll viewport by: %ld/%ld", diff_row, diff_col);
+
+	if (abs(diff_row) >= viewport->dim.row || abs(diff_col) >= viewport->dim.col) {
+		render_objects(frame, viewport, cursor);
+		return;
+	}
+
+	if (viewport->dim.row * HEX_STEP_ROW + HEX_SIZE / 2 > frame->dim.row || viewport->dim.col * HEX_STEP_COL + 1 > frame->dim.col) {
+		render_objects(frame, viewport, cursor);
+		return;
+	}
+
+	frame_shift(frame, target, -diff_row * HEX_STEP_ROW, -diff_col * HEX_STEP_COL);
+
+	//
+	// The objects are printed after the erasing, because the printed rows and
+	// columns overlap the erased areas.
+	//
+	if (diff_row > 0) {
+		frame_erase(frame, 0, 0, HEX_SIZE / 2, frame->dim.col);
+
+	} else if (diff_row < 0) {
+		frame_erase(frame, viewport->dim.row * HEX_STEP_ROW, 0, frame->dim.row, frame->dim.col);
+	}
+
+	if (diff_col > 0) {
+		frame_erase(frame, 0, 0, frame->dim.row, 1);
+
+	} else if (diff_col < 0) {
+		frame_erase(frame, 0, viewport->dim.col * HEX_STEP_COL, frame->dim.row, frame->dim.col);
+	}
+
+	//
+	// Print the newly visible rows with the first row or the newly visible rows
+	// with the last row.
+	//
+	if (diff_row > 0) {
+		render_objects_rect(frame, viewport, cursor, 0, 0, 1, viewport->dim.col);
+		render_objects_rect(frame, viewport, cursor, viewport->dim.row - diff_row, 0, diff_row, viewport->dim.col);
+
+	} else if (diff_row < 0) {
+		render_objects_rect(frame, viewport, cursor, 0, 0, -diff_row, viewport->dim.col);
+		render_objects_rect(frame, viewport, cursor, viewport->dim.row - 1, 0, 1, viewport->dim.col);
+	}
+
+	//
+	// Print the newly visible columns with the first column or the newly
+	// visible columns with the last column.
+	//
+	if (diff_col > 0) {
+		render_objects_rect(frame, viewport, cursor, 0, 0, viewport->dim.row, 1);
+		render_objects_rect(frame, viewport, cursor, 0, viewport->dim.col - diff_col, viewport->dim.row, diff_col);
+
+	} else if (diff_col < 0) {
+		render_objects_rect(frame, viewport, cursor, 0, 0, viewport->dim.row, -diff_col);
+		render_objects_rect(frame, viewport, cursor, 0, viewport->dim.col - 1, viewport->dim.row, 1);
+	}
+}
+
+/******************************************************************************
+ * The function prints the damaged objects, which are the objects that changed
+ * since the last print. Damaged objects outside the viewport are ignored,
+ * they are printed when the viewport moves to them. The object under the
+ * cursor is highlighted.
+ *****************************************************************************/
+
+void render_damaged(s_frame *frame, const s_viewport *viewport, const s_object *cursor) {
+	s_object *obj;
+
+	while ((obj = obj_area_damage_next()) != NULL) {
+
+		if (s_viewport_inside_viewport(viewport, &obj->pos)) {
+			render_object(frame, viewport, obj, obj == cursor);
+		}
+	}
+}
@@ -22,7 +22,20 @@
  * SOFTWARE.
  */
 
+#include <string.h>
+
 #include "hg_ship.h"
+#include "hg_color_pair.h"
+#include "hg_pool.h"
+
+/******************************************************************************
+ * The definition of the pool of ship instances. Released instances are reused
+ * and stale pointers are detected in the DEBUG mode.
+ *****************************************************************************/
+
+#define SHIP_INST_CHUNK 16
+
+static s_pool _ship_inst_pool;
 
 /******************************************************************************
  * The definition of the characters that are used for the ships.
@@ -70,20 +83,93 @@
 
 static char *_paths_normal[PATHS_MAX] = { "l", "cl", "c", "cc", "r", "cr", NULL };
 
+/******************************************************************************
+ * The definition of the ship types.
+ *****************************************************************************/
+
+static s_ship_type _ship_type[SHIP_TYPE_NUM];
+
+/******************************************************************************
+ * The function compiles the path strings of a ship type to a trie. The
+ * directions of the nodes are computed for each starting direction with
+ * e_dir_mv(), so walking the trie requires no interpretation of the path
+ * characters.
+ *****************************************************************************/
+
+static void ship_type_compile_paths(s_ship_type *ship_type) {
+
+	//
+	// The root node has no turn, so the direction is the starting direction.
+	//
+	s_path_node *root = &ship_type->path_trie[0];
+
+	memset(root, 0, sizeof(s_path_node));
+
+	for (int d = 0; d < DIR_NUM; d++) {
+		root->dir[d] = d;
+	}
+
+	ship_type->path_nodes = 1;
+
+	for (int i = 0; ship_type->paths[i] != NULL; i++) {
+		int idx = 0;
+
+		for (const char *ptr = ship_type->paths[i]; *ptr != '\0'; ptr++) {
+
+			//
+			// The turn index is computed from the direction change for the
+			// north direction: left => NW (0), center => NN (1), right => NE (2)
+			//
+			const int turn = (e_dir_mv(DIR_NN, *ptr) + 1) % DIR_NUM;
+
+			if (ship_type->path_trie[idx].child[turn] == 0) {
+
+				if (ship_type->path_nodes >= PATH_NODES_MAX) {
+					log_exit("Too many path nodes: %d", ship_type->path_nodes);
+				}
+
+				const int child = ship_type->path_nodes++;
+				s_path_node *node = &ship_type->path_trie[child];
+
+				memset(node, 0, sizeof(s_path_node));
+
+				for (int d = 0; d < DIR_NUM; d++) {
+					node->dir[d] = e_dir_mv(ship_type->path_trie[idx].dir[d], *ptr);
+				}
+
+				ship_type->path_trie[idx].child[turn] = child;
+			}
+
+			idx = ship_type->path_trie[idx].child[turn];
+		}
+
+		ship_type->path_trie[idx].end = true;
+	}
+
+	log_debug("Paths compiled to nodes: %d", ship_type->path_nodes);
+}
+
 /******************************************************************************
  * The function initializes the ship types. Currently we have only one ship
  * type and initializing means allocating colors.
  *****************************************************************************/
 
-static s_ship_type _ship_type[1];
-
 static void ship_type_init() {
 
+	_ship_type[SHIP_TYPE_NORMAL].type = SHIP_TYPE_NORMAL;
+
 	_ship_type[SHIP_TYPE_NORMAL].color[ST_ENGINE] = col_color_create(900, 800, 0);
 	_ship_type[SHIP_TYPE_NORMAL].color[ST_DARK] = col_color_create(300, 300, 700);
 	_ship_type[SHIP_TYPE_NORMAL].color[ST_LIGHT] = col_color_create(400, 400, 700);
 
 	_ship_type[SHIP_TYPE_NORMAL].paths = _paths_normal;
+
+	//
+	// A step forward costs 1 point and a turn costs an additional point.
+	//
+	_ship_type[SHIP_TYPE_NORMAL].move = (s_ship_move) { .points = 3, .cost = { 2, 1, 2 } };
+
+	ship_type_compile_paths(&_ship_type[SHIP_TYPE_NORMAL]);
 }
 
 /******************************************************************************
@@ -105,40 +191,6 @@ static void ship_type_init() {
 
 static s_hex_field _ship_field_templ[DIR_NUM];
 
-/******************************************************************************
- * The function copies the s_hex_field from the template to the given
- * s_hex_field. The colors from the template are mapped to the colors from the
- * s_ship_type.
- *****************************************************************************/
-
-void ship_get_hex_field(const s_ship_type *ship_type, const e_dir dir, s_hex_field *ship_field) {
-	s_hex_point *hp_templ, *hp_ship;
-
-	//
-	// Select the template for the given direction.
-	//
-	s_hex_field *hf_templ = &_ship_field_templ[dir];
-
-	for (int row = 0; row < HEX_SIZE; row++) {
-		for (int col = 0; col < HEX_SIZE; col++) {
-
-			//
-			// Store the s_hex_point's
-			//
-			hp_templ = &hf_templ->point[row][col];
-			hp_ship = &ship_field->point[row][col];
-
-			//
-			// Set the s_hex_point for the ship, with the mapped colors from
-			// the template.
-			//
-			hp_ship->chr = hp_templ->chr;
-			hp_ship->fg = ship_translate(hp_templ->fg, ship_type);
-			hp_ship->bg = ship_translate(hp_templ->bg, ship_type);
-		}
-	}
-}
-
 /******************************************************************************
  * The function initializes the ship templates. The template consists of 6 hex
  * blocks (for each direction).
@@ -280,6 +332,36 @@ static void ship_field_init_templ() {
 	hex_point_set(ship->point[3][2], Q_LRLX, ST_ENGINE, ST_UNDEF);
 }
 
+/******************************************************************************
+ * The function composes the sprites of a ship type from the templates. The
+ * colors from the templates are mapped to the colors of the ship type. The
+ * color pairs of points with a foreground and a background color are
+ * registered, the others depend on the background of the space.
+ *****************************************************************************/
+
+static void ship_type_init_sprites(s_ship_type *ship_type) {
+	const s_hex_point *hp_templ;
+	s_hex_point *hp_ship;
+
+	for (int dir = 0; dir < DIR_NUM; dir++) {
+		for (int row = 0; row < HEX_SIZE; row++) {
+			for (int col = 0; col < HEX_SIZE; col++) {
+
+				hp_templ = &_ship_field_templ[dir].point[row][col];
+				hp_ship = &ship_type->sprite[dir].point[row][col];
+
+				hp_ship->chr = hp_templ->chr;
+				hp_ship->fg = ship_translate(hp_templ->fg, ship_type);
+				hp_ship->bg = ship_translate(hp_templ->bg, ship_type);
+
+				if (hp_ship->chr != W_NULL && hp_ship->bg != COLOR_UNDEF) {
+					cp_color_pair_add(hp_ship->fg, hp_ship->bg);
+				}
+			}
+		}
+	}
+}
+
 /******************************************************************************
  * The function initializes the ship types and templates.
  *****************************************************************************/
@@ -297,43 +379,39 @@ void ship_field_init() {
 	//
 	ship_field_init_templ();
 
+	//
+	// Compose the sprites of the ship types.
+	//
+	ship_type_init_sprites(&_ship_type[SHIP_TYPE_NORMAL]);
+
+	//
+	// Initialize the pool of the ship instances.
+	//
+	pool_init(&_ship_inst_pool, "ship inst", sizeof(s_ship_inst), SHIP_INST_CHUNK);
+
 	log_debug_str("Ships ready to fly!");
 }
 
 /******************************************************************************
- * The definition of the array of ship instances that can be used. This means
- * that the number of ships are fix at the beginning of the game. Currently the
- * instances cannot be reused.
+ * The function frees the ship instances.
  *****************************************************************************/
 
-#define SHIP_INST_MAX 2
-
-static s_ship_inst _ship_inst[SHIP_INST_MAX];
-
-//
-// Number of used ship instances.
-//
-static int _ship_inst_num = 0;
+void ship_field_free() {
+	pool_free(&_ship_inst_pool);
+}
 
 /******************************************************************************
  * The function creates and initializes a ship instance. The instances are
- * taken from the array.
+ * taken from the pool.
  *****************************************************************************/
 
 s_ship_inst* s_ship_inst_create(const e_ship_type ship_type, const e_dir dir) {
 	s_ship_inst *ship_inst;
 
 	//
-	// Ensure that there is an unused ship instance left.
-	//
-	if (_ship_inst_num >= SHIP_INST_MAX) {
-		log_exit_str("Too many ship instances!");
-	}
-
-	//
-	// Get that instance.
+	// Get an instance.
 	//
-	ship_inst = &_ship_inst[_ship_inst_num++];
+	ship_inst = pool_alloc(&_ship_inst_pool);
 
 	//
 	// Set the values.
@@ -346,3 +424,20 @@ s_ship_inst* s_ship_inst_create(const e_ship_type ship_type, const e_dir dir) {
 	//
 	return ship_inst;
 }
+
+/******************************************************************************
+ * The function releases a ship instance, which is returned to the pool.
+ *****************************************************************************/
+
+void s_ship_inst_release(s_ship_inst *ship_inst) {
+	pool_release(&_ship_inst_pool, ship_inst);
+}
+
+/******************************************************************************
+ * The function terminates the program, if the ship instance was released. It
+ * is used to detect stale pointers in the DEBUG mode.
+ *****************************************************************************/
+
+void s_ship_inst_check(DEBUG_USED const s_ship_inst *ship_inst) {
+	pool_check(&_ship_inst_pool, ship_inst);
+}
@@ -23,18 +23,32 @@
  */
 
 #include <ncurses.h>
+#include <stdint.h>
 
 #include "hg_color.h"
 #include "hg_color_pair.h"
 #include "hg_space.h"
+#include "hg_trace.h"
 
 /******************************************************************************
- * The definition of the space array and the dimension of the space array.
+ * The definition of the space array and the dimension of the space array. The
+ * array is a single block, aligned to a cache line, in row-major order. The
+ * space has no state, except for the stars, so the array stores only the star
+ * mask of each hex field (see hex_star_bit()). The hex field itself is
+ * synthesized on demand.
+ *
+ * In the procedural mode there is no array. The stars are computed on demand
+ * from a hash of the seed and the position of the hex field, so the space has
+ * no size limits and the same seed results in the same space.
  *****************************************************************************/
 
 static s_point _dim_space;
 
-static s_hex_field **_space;
+static unsigned short *_space = NULL;
+
+static unsigned int _space_seed;
+
+#define space_idx(r,c) ((r) * _dim_space.col + (c))
 
 /******************************************************************************
  * The definition of the background colors. The color of the space is black, so
@@ -82,17 +96,11 @@ static void space_init_colors() {
  * The function allocates the array for the space field.
  *****************************************************************************/
 
-static s_hex_field** space_alloc(s_point *dim) {
+static unsigned short* space_alloc(s_point *dim) {
 
 	log_debug("Creating space with: %d/%d hex fields", dim->row, dim->col);
 
-	s_hex_field **space = xmalloc(sizeof(s_hex_field*) * dim->row);
-
-	for (int row = 0; row < dim->row; row++) {
-		space[row] = xmalloc(sizeof(s_hex_field) * dim->col);
-	}
-
-	return space;
+	return xmalloc_aligned(sizeof(unsigned short) * dim->row * dim->col);
 }
 
 /******************************************************************************
@@ -102,15 +110,13 @@ static s_hex_field** space_alloc(s_point *dim) {
 void space_free() {
 	log_debug_str("Freeing the space!");
 
-	for (int row = 0; row < _dim_space.row; row++) {
-		free(_space[row]);
-	}
-
 	free(_space);
+	_space = NULL;
 }
 
 /******************************************************************************
- * The function initializes a 4x4 hex field with empty chars or stars:
+ * The function creates the star mask of a hex field. The 4 corners of the 4x4
+ * array are not part of the hex field, so the mask has at most 12 bits set:
  *
  *  ##
  * ####
@@ -123,68 +129,81 @@ void space_free() {
 //
 #define RAND_START 24
 
-static void space_hex_field_init(s_hex_field *hex_field) {
-
-#ifdef DEBUG
-	int n_stars = 0;
-#endif
+static unsigned short space_stars_create() {
+	unsigned short stars = 0;
 
 	for (int row = 0; row < HEX_SIZE; row++) {
 		for (int col = 0; col < HEX_SIZE; col++) {
 
-			//
-			// The background color is defined by the state of the hex field.
-			//
-			hex_field->point[row][col].bg = COLOR_UNDEF;
-
-			//
-			// The 4 corners of the array are not necessary for the hex field.
-			//
-			if (hex_field_is_corner(row, col)) {
-				hex_field->point[row][col].chr = W_NULL;
-				hex_field->point[row][col].fg = COLOR_UNDEF;
-			}
-
 			//
 			// We use a random distribution for the stars.
 			//
-			else if (rand() % RAND_START == 0) {
-				hex_field->point[row][col].chr = W_STAR;
-				hex_field->point[row][col].fg = COLOR_WHITE;
-#ifdef DEBUG
-				n_stars++;
-#endif
+			if (!hex_field_is_corner(row, col) && rand() % RAND_START == 0) {
+				stars |= hex_star_bit(row, col);
 			}
+		}
+	}
 
-			//
-			// The rest of the chars are empty.
-			//
-			else {
-				hex_field->point[row][col].chr = W_EMPTY;
-				hex_field->point[row][col].fg = COLOR_WHITE;
+	return stars;
+}
+
+/******************************************************************************
+ * The function mixes the bits of a 64 bit value (splitmix64 finalizer). It is
+ * a counter based hash, so consecutive values result in unrelated hashes.
+ *****************************************************************************/
+
+static uint64_t space_hash(uint64_t x) {
+
+	x += 0x9E3779B97F4A7C15ULL;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+
+	return x ^ (x >> 31);
+}
+
+/******************************************************************************
+ * The function computes the star mask of a hex field from the seed and the
+ * index of the hex field. Each point of the hex field is a star, if the hash
+ * of the (seed, row, col, point) is a multiple of RAND_START, so the stars
+ * have the same distribution as the random stars.
+ *****************************************************************************/
+
+unsigned short space_stars_hash(const unsigned int seed, const int hex_row, const int hex_col) {
+	unsigned short stars = 0;
+
+	//
+	// The key of the hex field, which is the counter base for the points.
+	//
+	const uint64_t key = space_hash(((uint64_t) seed << 32) ^ space_hash(((uint64_t) (uint32_t) hex_row << 32) | (uint32_t) hex_col));
+
+	for (int row = 0; row < HEX_SIZE; row++) {
+		for (int col = 0; col < HEX_SIZE; col++) {
+
+			if (!hex_field_is_corner(row, col) && space_hash(key + (uint64_t) (row * HEX_SIZE + col)) % RAND_START == 0) {
+				stars |= hex_star_bit(row, col);
 			}
 		}
 	}
 
-	log_debug("stars: %d from: 12", n_stars);
+	return stars;
 }
 
 /******************************************************************************
- * The function initializes the space field with empty chars or dots (which
- * represent stars).
+ * The function initializes the space array with the star masks.
  *****************************************************************************/
 
-static void space_hex_fields_init(s_hex_field **space, s_point *dim) {
+static void space_stars_init(unsigned short *space, s_point *dim) {
 
 	for (int row = 0; row < dim->row; row++) {
 		for (int col = 0; col < dim->col; col++) {
-			space_hex_field_init(&space[row][col]);
+			space[space_idx(row, col)] = space_stars_create();
 		}
 	}
 }
 
 /******************************************************************************
- * The function initializes the background space.
+ * The function initializes the background space with random stars, which are
+ * created eagerly for all hex fields.
  *****************************************************************************/
 
 void space_init(s_point *dim_hex) {
@@ -204,7 +223,7 @@ void space_init(s_point *dim_hex) {
 	//
 	// Create stars
 	//
-	space_hex_fields_init(_space, dim_hex);
+	space_stars_init(_space, dim_hex);
 
 	//
 	// Initialize the colors
@@ -213,27 +232,38 @@ void space_init(s_point *dim_hex) {
 }
 
 /******************************************************************************
- * The function copies the content of the hex field from the space array to the
- * hex field, given by the parameter. The background color is adjusted
- * depending on the state of the space hex field.
+ * The function initializes the background space in the procedural mode. The
+ * stars are not stored, they are computed from the seed, when a hex field is
+ * rendered, so the initialization does not depend on the size of the space.
  *****************************************************************************/
 
-void space_get_hex_field(const s_point *hex_idx, const int color_idx, const bool highlight, s_hex_field *space_field) {
+void space_init_seed(s_point *dim_hex, const unsigned int seed) {
 
-#ifdef DEBUG
+	log_debug("Init space with seed: %u", seed);
 
 	//
-	// Ensure that the index is inside the allowed ranges.
+	// Store the dimensions and the seed
 	//
-	if (hex_idx->row < 0 || hex_idx->row >= _dim_space.row || hex_idx->col < 0 || hex_idx->col >= _dim_space.col) {
-		log_debug("hex field index out of range: %d/%d", hex_idx->row, hex_idx->col);
-	}
-#endif
+	s_point_set(&_dim_space, dim_hex->row, dim_hex->col);
+
+	_space_seed = seed;
+
+	_space = NULL;
 
 	//
-	// The hex field from the space array, which is the template.
+	// Initialize the colors
 	//
-	const s_hex_field *space_tmpl = &_space[hex_idx->row][hex_idx->col];
+	space_init_colors();
+}
+
+/******************************************************************************
+ * The function sets the hex field, given by the parameter, to empty space.
+ * The background color depends on the state of the space hex field and the
+ * shading. The hex field has no stars, they are a separate layer, which is
+ * returned by space_get_stars().
+ *****************************************************************************/
+
+void space_get_hex_field(const int color_idx, const bool highlight, s_hex_field *space_field) {
 
 	//
 	//	 The background color, which depends on the state of the space hex field
@@ -251,9 +281,36 @@ void space_get_hex_field(const s_point *hex_idx, const int color_idx, const bool
 				continue;
 			}
 
-			space_field->point[row][col].chr = space_tmpl->point[row][col].chr;
-			space_field->point[row][col].fg = space_tmpl->point[row][col].fg;
+			space_field->point[row][col].chr = W_EMPTY;
+			space_field->point[row][col].fg = COLOR_WHITE;
 			space_field->point[row][col].bg = color_space_bg;
 		}
 	}
 }
+
+/******************************************************************************
+ * The function returns the star mask of a hex field of the space. The mask has
+ * a bit for each point with a star (see hex_star_bit()).
+ *****************************************************************************/
+
+unsigned short space_get_stars(const s_point *hex_idx) {
+
+#ifdef DEBUG
+
+	//
+	// Ensure that the index is inside the allowed ranges.
+	//
+	if (hex_idx->row < 0 || hex_idx->row >= _dim_space.row || hex_idx->col < 0 || hex_idx->col >= _dim_space.col) {
+		trace_event(TRACE_WARN, TRACE_AREA, "hex field index out of range: %ld/%ld", hex_idx->row, hex_idx->col);
+	}
+#endif
+
+	//
+	// In the procedural mode the stars are computed on demand.
+	//
+	if (_space == NULL) {
+		return space_stars_hash(_space_seed, hex_idx->row, hex_idx->col);
+	}
+
+	return _space[space_idx(hex_idx->row, hex_idx->col)];
+}
@@ -0,0 +1,208 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "hg_target.h"
+#include "hg_ncurses.h"
+
+/******************************************************************************
+ * The function sets all cells of a buffer to blank.
+ *****************************************************************************/
+
+void target_cells_blank(s_cell *cells, const int num) {
+
+	for (int i = 0; i < num; i++) {
+		cell_set_blank(&cells[i]);
+	}
+}
+
+/******************************************************************************
+ * The function shifts the cells of a buffer. Positive values shift the cells
+ * down / right, negative values shift them up / left. The uncovered cells are
+ * blank.
+ *****************************************************************************/
+
+void target_cells_shift(const s_point *dim, s_cell *cells, const int rows, const int cols) {
+
+	if (abs(rows) >= dim->row || abs(cols) >= dim->col) {
+		target_cells_blank(cells, dim->row * dim->col);
+		return;
+	}
+
+	//
+	// Shift the rows, which are contiguous.
+	//
+	if (rows > 0) {
+		memmove(&cells[rows * dim->col], cells, sizeof(s_cell) * (dim->row - rows) * dim->col);
+		target_cells_blank(cells, rows * dim->col);
+
+	} else if (rows < 0) {
+		memmove(cells, &cells[-rows * dim->col], sizeof(s_cell) * (dim->row + rows) * dim->col);
+		target_cells_blank(&cells[(dim->row + rows) * dim->col], -rows * dim->col);
+	}
+
+	if (cols == 0) {
+		return;
+	}
+
+	//
+	// Shift the cells of each row.
+	//
+	const int num = dim->col - abs(cols);
+
+	for (int row = 0; row < dim->row; row++) {
+		s_cell *line = &cells[row * dim->col];
+
+		if (cols > 0) {
+			memmove(&line[cols], line, sizeof(s_cell) * num);
+			target_cells_blank(line, cols);
+
+		} else {
+			memmove(line, &line[-cols], sizeof(s_cell) * num);
+			target_cells_blank(&line[num], -cols);
+		}
+	}
+}
+
+/******************************************************************************
+ * The function writes a run of cells to the window of the ncurses backend.
+ * The run is written with a single call, even if the cells have different
+ * color pairs.
+ *****************************************************************************/
+
+static void target_ncur_write(s_target *target, const int row, const int col, const s_cell *cells, const int num) {
+	wchar_t chr[2] = { L'\0', L'\0' };
+	cchar_t run[num];
+
+	for (int i = 0; i < num; i++) {
+		chr[0] = cells[i].chr;
+		setcchar(&run[i], chr, A_NORMAL, cells[i].cp, NULL);
+	}
+
+	//
+	// Adding cells merges the current attributes of the window.
+	//
+	wattr_set(target->win, A_NORMAL, 0, NULL);
+
+	mvwadd_wchnstr(target->win, row, col, run, num);
+}
+
+/******************************************************************************
+ * The function shifts the content of the window of the ncurses backend.
+ *****************************************************************************/
+
+static void target_ncur_shift(s_target *target, const int rows, const int cols) {
+	ncur_win_shift(target->win, rows, cols);
+}
+
+/******************************************************************************
+ * The function creates a render target for an ncurses window.
+ *****************************************************************************/
+
+s_target* target_ncur_create(WINDOW *win) {
+
+	s_target *target = xmalloc(sizeof(s_target));
+
+	s_point_set(&target->dim, getmaxy(win), getmaxx(win));
+
+	log_debug("Creating ncurses target with: %d/%d", target->dim.row, target->dim.col);
+
+	target->write = target_ncur_write;
+	target->shift = target_ncur_shift;
+
+	target->win = win;
+	target->cells = NULL;
+
+	return target;
+}
+
+/******************************************************************************
+ * The function writes a run of cells to the grid of the memory backend.
+ *****************************************************************************/
+
+static void target_mem_write(s_target *target, const int row, const int col, const s_cell *cells, const int num) {
+	memcpy(target_mem_cell(target, row, col), cells, sizeof(s_cell) * num);
+}
+
+/******************************************************************************
+ * The function shifts the grid of the memory backend.
+ *****************************************************************************/
+
+static void target_mem_shift(s_target *target, const int rows, const int cols) {
+	target_cells_shift(&target->dim, target->cells, rows, cols);
+}
+
+/******************************************************************************
+ * The function creates a render target for a grid of cells in memory. The
+ * cells are blank, like a new window.
+ *****************************************************************************/
+
+s_target* target_mem_create(const s_point *dim) {
+
+	log_debug("Creating memory target with: %d/%d", dim->row, dim->col);
+
+	s_target *target = xmalloc(sizeof(s_target));
+
+	s_point_copy(&target->dim, dim);
+
+	target->write = target_mem_write;
+	target->shift = target_mem_shift;
+
+	target->win = NULL;
+	target->cells = xmalloc(sizeof(s_cell) * dim->row * dim->col);
+
+	target_cells_blank(target->cells, dim->row * dim->col);
+
+	return target;
+}
+
+/******************************************************************************
+ * The function copies the characters of a row of the memory backend to a
+ * line, which has to have space for the terminating null character.
+ *****************************************************************************/
+
+void target_mem_line(const s_target *target, const int row, wchar_t *line) {
+
+	for (int col = 0; col < target->dim.col; col++) {
+		line[col] = target_mem_cell(target, row, col)->chr;
+	}
+
+	line[target->dim.col] = L'\0';
+}
+
+/******************************************************************************
+ * The function frees the render target. The window of the ncurses backend is
+ * not owned by the target.
+ *****************************************************************************/
+
+void target_free(s_target *target) {
+	log_debug_str("Freeing the target!");
+
+	if (target->cells != NULL) {
+		free(target->cells);
+	}
+
+	free(target);
+}
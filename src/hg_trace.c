@@ -0,0 +1,200 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdatomic.h>
+#include <string.h>
+#include <time.h>
+
+#include "hg_trace.h"
+
+/******************************************************************************
+ * The filter for the events. By default all events are recorded.
+ *****************************************************************************/
+
+e_trace_level _trace_level = TRACE_DEBUG;
+
+int _trace_categories = TRACE_CATEGORY_ALL;
+
+/******************************************************************************
+ * The definition of a trace event. The event stores the format string and
+ * the arguments, the formatting is done when the events are dumped.
+ *
+ * The sequence number is used as a seqlock. A writer sets it to 0 before it
+ * writes the fields and to the position in the ring buffer plus 1 after it.
+ * A reader copies the fields and accepts the copy only if the sequence number
+ * is the same before and after the copy.
+ *****************************************************************************/
+
+typedef struct {
+
+	atomic_ulong seq;
+
+	long time;
+
+	e_trace_level level;
+
+	e_trace_category category;
+
+	const char *func;
+
+	const char *fmt;
+
+	long args[TRACE_ARGS];
+
+} s_trace_event;
+
+/******************************************************************************
+ * The ring buffer with the events. The size (TRACE_SIZE) is a power of 2, so
+ * the index is a mask of the position. A writer reserves a position by incrementing the
+ * head, so no lock is required. If the ring buffer is full, the oldest events
+ * are overwritten.
+ *****************************************************************************/
+
+#define TRACE_MASK (TRACE_SIZE - 1)
+
+static s_trace_event _trace_ring[TRACE_SIZE];
+
+static atomic_ulong _trace_head = 0;
+
+/******************************************************************************
+ * The function returns the time in nanoseconds from a monotonic clock.
+ *****************************************************************************/
+
+static long trace_time() {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+/******************************************************************************
+ * The function records an event in the ring buffer. The arguments are
+ * optional.
+ *****************************************************************************/
+
+void trace_add(const e_trace_level level, const e_trace_category category, const char *func, const char *fmt, const long *args) {
+
+	const unsigned long pos = atomic_fetch_add_explicit(&_trace_head, 1, memory_order_relaxed);
+
+	s_trace_event *event = &_trace_ring[pos & TRACE_MASK];
+
+	//
+	// Mark the event as incomplete before the fields are written.
+	//
+	atomic_store_explicit(&event->seq, 0, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+
+	event->time = trace_time();
+	event->level = level;
+	event->category = category;
+	event->func = func;
+	event->fmt = fmt;
+
+	if (args != NULL) {
+		memcpy(event->args, args, sizeof(long) * TRACE_ARGS);
+	}
+
+	atomic_store_explicit(&event->seq, pos + 1, memory_order_release);
+}
+
+/******************************************************************************
+ * The names of the levels and the categories, which are used for the dump.
+ *****************************************************************************/
+
+static const char *_trace_level_str[] = { "DEBUG", "INFO", "WARN" };
+
+static const char *_trace_category_str[] = { "render", "input", "color", "area" };
+
+/******************************************************************************
+ * The function formats the events of the ring buffer and writes them to the
+ * stream, starting with the oldest event. The time is relative to the oldest
+ * event. Events that are written or overwritten while they are copied are
+ * skipped. The function returns the number of dumped events.
+ *****************************************************************************/
+
+#define TRACE_LINE 256
+
+int trace_dump(FILE *stream) {
+	char line[TRACE_LINE];
+	long time_start = 0;
+	int num = 0;
+
+	const unsigned long head = atomic_load_explicit(&_trace_head, memory_order_acquire);
+
+	for (unsigned long pos = head > TRACE_SIZE ? head - TRACE_SIZE : 0; pos < head; pos++) {
+
+		s_trace_event *event = &_trace_ring[pos & TRACE_MASK];
+
+		const unsigned long seq = atomic_load_explicit(&event->seq, memory_order_acquire);
+
+		if (seq != pos + 1) {
+			continue;
+		}
+
+		//
+		// Copy the fields and check that the event was not changed while
+		// copying.
+		//
+		const long time = event->time;
+		const e_trace_level level = event->level;
+		const e_trace_category category = event->category;
+		const char *func = event->func;
+		const char *fmt = event->fmt;
+		long args[TRACE_ARGS];
+
+		memcpy(args, event->args, sizeof(long) * TRACE_ARGS);
+
+		atomic_thread_fence(memory_order_acquire);
+
+		if (atomic_load_explicit(&event->seq, memory_order_relaxed) != seq) {
+			continue;
+		}
+
+		if (num == 0) {
+			time_start = time;
+		}
+
+		snprintf(line, TRACE_LINE, fmt, args[0], args[1], args[2], args[3]);
+
+		fprintf(stream, "TRACE %12.3f us %-5s %-6s %s() %s\n", (time - time_start) / 1e3, _trace_level_str[level], _trace_category_str[category], func, line);
+
+		num++;
+	}
+
+	return num;
+}
+
+/******************************************************************************
+ * The function removes all events from the ring buffer.
+ *****************************************************************************/
+
+void trace_reset() {
+
+	for (int i = 0; i < TRACE_SIZE; i++) {
+		atomic_store_explicit(&_trace_ring[i].seq, 0, memory_order_relaxed);
+	}
+
+	atomic_store_explicit(&_trace_head, 0, memory_order_release);
+}
@@ -23,6 +23,7 @@
  */
 
 #include "hg_viewport.h"
+#include "hg_trace.h"
 
 /******************************************************************************
  * The function check if a point is inside the viewpoint.
@@ -53,7 +54,7 @@ bool s_viewport_inside_viewport(const s_viewport *viewport, const s_point *idx)
 bool s_viewport_update(s_viewport *viewport, const s_point *pos_new) {
 	bool do_update = false;
 
-	log_debug("Viewport pos: %d/%d new: %d/%d", viewport->pos.row, viewport->pos.col, pos_new->row, pos_new->col);
+	trace_event(TRACE_DEBUG, TRACE_INPUT, "Viewport pos: %ld/%ld new: %ld/%ld", viewport->pos.row, viewport->pos.col, pos_new->row, pos_new->col);
 
 	//
 	// Update row
@@ -92,7 +93,7 @@ bool s_viewport_update(s_viewport *viewport, const s_point *pos_new) {
 	}
 
 	if (do_update) {
-		log_debug("Viewport pos updated: %d/%d", viewport->pos.row, viewport->pos.col);
+		trace_event(TRACE_DEBUG, TRACE_INPUT, "Viewport pos updated: %ld/%ld", viewport->pos.row, viewport->pos.col);
 	}
 
 	return do_update;
@@ -130,7 +131,7 @@ bool s_viewport_mv_diff(s_viewport *viewport, const s_point *diff) {
 		return false;
 	}
 
-	log_debug("pos from: %d/%d to: %d/%d", viewport->pos.row, viewport->pos.col, new_pos.row, new_pos.col);
+	trace_event(TRACE_DEBUG, TRACE_INPUT, "pos from: %ld/%ld to: %ld/%ld", viewport->pos.row, viewport->pos.col, new_pos.row, new_pos.col);
 
 	viewport->pos.row = new_pos.row;
 	viewport->pos.col = new_pos.col;
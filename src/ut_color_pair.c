@@ -71,6 +71,28 @@ static void test_color_pair_add_get() {
 
 	cp_get = cp_color_pair_get(1, 2);
 	ut_check_short(cp_12, cp_get, "Test again: 1, 2");
+
+	//
+	// The lookup table
+	//
+	ut_check_short(cp_color_pair_lookup(1, 1), cp_11, "Lookup: 1, 1");
+	ut_check_short(cp_color_pair_lookup(2, 1), cp_21, "Lookup: 2, 1");
+	ut_check_short(cp_color_pair_lookup(1, 2), cp_12, "Lookup: 1, 2");
+
+	//
+	// Lookup => Add
+	//
+	cp_add = cp_color_pair_lookup(4, 4);
+	cp_get = cp_color_pair_get(4, 4);
+	ut_check_short(cp_add, cp_get, "lookup get");
+
+	//
+	// After a reset the color pairs are registered again.
+	//
+	cp_color_pair_reset();
+
+	ut_check_short(_cp_table[1][1], CP_UNDEF, "reset: undefined");
+	ut_check_short(cp_color_pair_get(2, 2), cp_11, "reset: first pair");
 }
 
 /******************************************************************************
@@ -92,5 +114,7 @@ void ut_color_pair_exec() {
 
 	test_color_pair_add_get();
 
+	cp_color_pair_reset();
+
 	endwin();
 }
@@ -0,0 +1,110 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hg_common.h"
+#include "ut_utils.h"
+
+/******************************************************************************
+ * The function checks that the allocations of the arena are aligned and that
+ * the memory is reused after a reset.
+ *****************************************************************************/
+
+static void test_arena_reset() {
+	s_arena arena;
+
+	arena_init(&arena);
+
+	char *c = arena_alloc(&arena, 1);
+	double *d = arena_alloc(&arena, sizeof(double));
+
+	ut_check_bool((uintptr_t) d % _Alignof(max_align_t) == 0, true, "reset: aligned");
+	ut_check_bool((char*) d > c, true, "reset: bump pointer");
+
+	arena_reset(&arena);
+
+	ut_check_bool(arena_alloc(&arena, 1) == c, true, "reset: memory reused");
+
+	arena_free(&arena);
+
+	ut_check_bool(arena.mem == NULL, true, "reset: freed");
+}
+
+/******************************************************************************
+ * The function checks that the arena grows beyond a block and that the reset
+ * replaces the blocks with a single block, which is large enough for the same
+ * allocations.
+ *****************************************************************************/
+
+static void test_arena_grow() {
+	s_arena arena;
+	int *ptrs[64];
+	const size_t size = 1000 * sizeof(int);
+
+	arena_init(&arena);
+
+	for (int i = 0; i < 64; i++) {
+		ptrs[i] = arena_alloc(&arena, size);
+		ptrs[i][0] = i;
+		ptrs[i][999] = i;
+	}
+
+	int stable = 0;
+
+	for (int i = 0; i < 64; i++) {
+		if (ptrs[i][0] == i && ptrs[i][999] == i) {
+			stable++;
+		}
+	}
+
+	ut_check_int(stable, 64, "grow: stable pointers");
+	ut_check_bool(*(char**) arena.mem != NULL, true, "grow: more than one block");
+
+	arena_reset(&arena);
+
+	ut_check_bool(*(char**) arena.mem == NULL, true, "grow: single block");
+
+	char *mem = arena.mem;
+
+	for (int i = 0; i < 64; i++) {
+		arena_alloc(&arena, size);
+	}
+
+	ut_check_bool(arena.mem == mem, true, "grow: no new block");
+
+	arena_free(&arena);
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests.
+ *****************************************************************************/
+
+void ut_common_exec() {
+
+	test_arena_reset();
+
+	test_arena_grow();
+}
@@ -0,0 +1,283 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "hg_cube.h"
+#include "hg_obj_area.h"
+#include "ut_utils.h"
+
+/******************************************************************************
+ * The function checks the conversion from offset coordinates to cube
+ * coordinates and back, including negative coordinates.
+ *****************************************************************************/
+
+static void test_cube_offset() {
+	s_point offset, result;
+	s_cube cube;
+	int num = 0;
+
+	for (offset.row = -5; offset.row < 5; offset.row++) {
+		for (offset.col = -5; offset.col < 5; offset.col++) {
+
+			cube_from_offset(&offset, &cube);
+			cube_to_offset(&cube, &result);
+
+			if (s_point_same(&offset, &result) && cube.q + cube.r + cube.s == 0) {
+				num++;
+			}
+		}
+	}
+
+	ut_check_int(num, 100, "offset: round trip");
+}
+
+/******************************************************************************
+ * The function checks that the neighbours in cube coordinates are the same as
+ * in offset coordinates (obj_area_goto).
+ *****************************************************************************/
+
+static void test_cube_neighbour() {
+	s_point offset, offset_to, result;
+	s_cube cube, cube_to;
+	int num = 0;
+
+	for (offset.row = -4; offset.row < 4; offset.row++) {
+		for (offset.col = -4; offset.col < 4; offset.col++) {
+			for (e_dir dir = 0; dir < DIR_NUM; dir++) {
+
+				obj_area_goto(&offset, dir, &offset_to);
+
+				cube_from_offset(&offset, &cube);
+				cube_neighbour(&cube, dir, &cube_to);
+				cube_to_offset(&cube_to, &result);
+
+				if (s_point_same(&offset_to, &result)) {
+					num++;
+				}
+			}
+		}
+	}
+
+	ut_check_int(num, 8 * 8 * DIR_NUM, "neighbour: offset");
+}
+
+/******************************************************************************
+ * The function checks the distance against a breadth first search with
+ * obj_area_goto on a DIST_DIM x DIST_DIM area.
+ *****************************************************************************/
+
+#define DIST_DIM 21
+
+static void test_cube_distance() {
+	int dist[DIST_DIM][DIST_DIM];
+	s_point queue[DIST_DIM * DIST_DIM];
+	const s_point dim = { .row = DIST_DIM, .col = DIST_DIM };
+	const s_point center = { .row = DIST_DIM / 2, .col = DIST_DIM / 2 };
+	s_point to;
+
+	memset(dist, -1, sizeof(dist));
+
+	int head = 0, tail = 0;
+
+	queue[tail++] = center;
+	dist[center.row][center.col] = 0;
+
+	while (head < tail) {
+		const s_point from = queue[head++];
+
+		for (e_dir dir = 0; dir < DIR_NUM; dir++) {
+			obj_area_goto(&from, dir, &to);
+
+			if (s_point_inside(&dim, &to) && dist[to.row][to.col] < 0) {
+				dist[to.row][to.col] = dist[from.row][from.col] + 1;
+				queue[tail++] = to;
+			}
+		}
+	}
+
+	//
+	// Only hex fields with a distance, that is not influenced by the borders.
+	//
+	int num = 0, num_same = 0;
+
+	for (to.row = 0; to.row < DIST_DIM; to.row++) {
+		for (to.col = 0; to.col < DIST_DIM; to.col++) {
+
+			if (dist[to.row][to.col] > DIST_DIM / 4) {
+				continue;
+			}
+
+			num++;
+
+			if (cube_offset_distance(&center, &to) == dist[to.row][to.col]) {
+				num_same++;
+			}
+		}
+	}
+
+	ut_check_int(num, cube_spiral_num(DIST_DIM / 4), "distance: num");
+	ut_check_int(num_same, num, "distance: bfs");
+}
+
+/******************************************************************************
+ * The function checks the rings and the spirals.
+ *****************************************************************************/
+
+#define RADIUS 4
+
+static void test_cube_ring_spiral() {
+	s_cube center, ring[cube_ring_num(RADIUS)], spiral[cube_spiral_num(RADIUS)];
+
+	s_cube_set(&center, 3, -7);
+
+	//
+	// All hex fields of the ring have the distance of the radius and
+	// consecutive hex fields are neighbours.
+	//
+	const int num = cube_ring(&center, RADIUS, ring);
+	int num_ok = 0;
+
+	for (int i = 0; i < num; i++) {
+		if (cube_distance(&center, &ring[i]) == RADIUS && cube_distance(&ring[i], &ring[(i + 1) % num]) == 1) {
+			num_ok++;
+		}
+	}
+
+	ut_check_int(num, 6 * RADIUS, "ring: num");
+	ut_check_int(num_ok, num, "ring: distance");
+
+	//
+	// The spiral has no duplicates and is ordered by the distance.
+	//
+	const int num_spiral = cube_spiral(&center, RADIUS, spiral);
+	int num_dup = 0, num_order = 0;
+
+	for (int i = 0; i < num_spiral; i++) {
+		for (int j = i + 1; j < num_spiral; j++) {
+			if (s_cube_same(&spiral[i], &spiral[j])) {
+				num_dup++;
+			}
+		}
+
+		if (i > 0 && cube_distance(&center, &spiral[i - 1]) > cube_distance(&center, &spiral[i])) {
+			num_order++;
+		}
+	}
+
+	ut_check_int(num_spiral, 61, "spiral: num");
+	ut_check_int(num_dup, 0, "spiral: duplicates");
+	ut_check_int(num_order, 0, "spiral: order");
+	ut_check_bool(s_cube_same(&spiral[0], &center), true, "spiral: center");
+}
+
+/******************************************************************************
+ * The function checks the lines.
+ *****************************************************************************/
+
+static void test_cube_line() {
+	s_cube from, to, line[32];
+
+	s_cube_set(&from, -2, 5);
+	s_cube_set(&to, 9, -8);
+
+	const int num = cube_line(&from, &to, line);
+	int num_ok = 0;
+
+	for (int i = 1; i < num; i++) {
+		if (cube_distance(&line[i - 1], &line[i]) == 1) {
+			num_ok++;
+		}
+	}
+
+	ut_check_int(num, cube_distance(&from, &to) + 1, "line: num");
+	ut_check_int(num_ok, num - 1, "line: steps");
+	ut_check_bool(s_cube_same(&line[0], &from) && s_cube_same(&line[num - 1], &to), true, "line: ends");
+
+	//
+	// A line along a direction.
+	//
+	s_cube_set(&to, from.q, from.r + 3);
+
+	cube_line(&from, &to, line);
+
+	ut_check_int(line[2].q, from.q, "line: straight q");
+	ut_check_int(line[2].r, from.r + 2, "line: straight r");
+
+	ut_check_int(cube_line(&from, &from, line), 1, "line: point");
+}
+
+/******************************************************************************
+ * The function checks the rotation.
+ *****************************************************************************/
+
+static void test_cube_rotate() {
+	s_cube center, from, to, exp;
+
+	s_cube_set(&center, 1, 1);
+
+	//
+	// Rotating the northern neighbour clockwise results in the north east
+	// neighbour.
+	//
+	cube_neighbour(&center, DIR_NN, &from);
+	cube_neighbour(&center, DIR_NE, &exp);
+
+	cube_rotate(&center, &from, 1, &to);
+	ut_check_bool(s_cube_same(&to, &exp), true, "rotate: clockwise");
+
+	cube_rotate(&center, &from, -1, &to);
+	cube_neighbour(&center, DIR_NW, &exp);
+	ut_check_bool(s_cube_same(&to, &exp), true, "rotate: counter clockwise");
+
+	//
+	// 6 steps are the identity and the distance does not change.
+	//
+	s_cube_set(&from, 5, -3);
+
+	cube_rotate(&center, &from, 6, &to);
+	ut_check_bool(s_cube_same(&to, &from), true, "rotate: identity");
+
+	cube_rotate(&center, &from, 2, &to);
+	ut_check_int(cube_distance(&center, &to), cube_distance(&center, &from), "rotate: distance");
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests.
+ *****************************************************************************/
+
+void ut_cube_exec() {
+
+	test_cube_offset();
+
+	test_cube_neighbour();
+
+	test_cube_distance();
+
+	test_cube_ring_spiral();
+
+	test_cube_line();
+
+	test_cube_rotate();
+}
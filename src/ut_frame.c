@@ -0,0 +1,167 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "hg_frame.h"
+#include "ut_utils.h"
+
+/******************************************************************************
+ * The function checks the character and the color pair of a cell of the
+ * current frame.
+ *****************************************************************************/
+
+#define BUF_SIZE 64
+
+static void check_cell(const s_frame *frame, const int row, const int col, const wchar_t chr, const short cp) {
+	char buffer[BUF_SIZE];
+
+	const s_cell *cell = frame_cell(frame, frame->cur, row, col);
+
+	snprintf(buffer, BUF_SIZE, "chr - cell: %d/%d", row, col);
+	ut_check_int(cell->chr, chr, buffer);
+
+	snprintf(buffer, BUF_SIZE, "cp - cell: %d/%d", row, col);
+	ut_check_short(cell->cp, cp, buffer);
+}
+
+/******************************************************************************
+ * The function checks that the cells of the memory target are the current
+ * cells of the frame, which is the case after a flush.
+ *****************************************************************************/
+
+static void check_target(const s_frame *frame, const s_target *target) {
+
+	for (int row = 0; row < frame->dim.row; row++) {
+		for (int col = 0; col < frame->dim.col; col++) {
+
+			if (!frame_cell_same(frame_cell(frame, frame->cur, row, col), target_mem_cell(target, row, col))) {
+				log_exit("Target differs from frame at: %d/%d", row, col);
+			}
+		}
+	}
+}
+
+/******************************************************************************
+ * The function checks that only changed cells are flushed.
+ *****************************************************************************/
+
+static void test_frame_flush(s_target *target) {
+	const s_point dim = { .row = 4, .col = 8 };
+
+	s_frame *frame = frame_create(&dim);
+
+	//
+	// A new frame is blank like the target.
+	//
+	ut_check_int(frame_flush(frame, target), 0, "flush: new");
+
+	frame_set(frame, 1, 2, L'a', 1);
+	frame_set(frame, 1, 3, L'b', 2);
+	frame_set(frame, 2, 7, L'c', 1);
+
+	ut_check_int(frame_flush(frame, target), 3, "flush: set");
+	ut_check_int(frame_flush(frame, target), 0, "flush: unchanged");
+
+	//
+	// Setting the same cell is not a change.
+	//
+	frame_set(frame, 1, 2, L'a', 1);
+	frame_set(frame, 1, 3, L'b', 3);
+
+	ut_check_int(frame_flush(frame, target), 1, "flush: color pair");
+
+	//
+	// Erasing cells is a change.
+	//
+	frame_erase(frame, 0, 0, 2, 8);
+
+	check_cell(frame, 1, 2, L' ', 0);
+	check_cell(frame, 2, 7, L'c', 1);
+
+	ut_check_int(frame_flush(frame, target), 2, "flush: erase");
+
+	check_target(frame, target);
+
+	frame_free(frame);
+}
+
+/******************************************************************************
+ * The function checks the shifting of the frame. The frame and the target are
+ * shifted, so nothing has to be flushed.
+ *****************************************************************************/
+
+static void test_frame_shift(s_target *target) {
+	const s_point dim = { .row = 4, .col = 8 };
+
+	s_frame *frame = frame_create(&dim);
+
+	frame_set(frame, 1, 1, L'a', 1);
+	frame_set(frame, 2, 6, L'b', 2);
+	frame_flush(frame, target);
+
+	//
+	// Shift down / right
+	//
+	frame_shift(frame, target, 1, 1);
+
+	check_cell(frame, 1, 1, L' ', 0);
+	check_cell(frame, 2, 2, L'a', 1);
+	check_cell(frame, 3, 7, L'b', 2);
+
+	ut_check_int(frame_flush(frame, target), 0, "shift: down / right");
+
+	//
+	// Shift up / left. The cell 'a' leaves the frame.
+	//
+	frame_shift(frame, target, -3, -2);
+
+	check_cell(frame, 0, 5, L'b', 2);
+	check_cell(frame, 2, 2, L' ', 0);
+
+	ut_check_int(frame_flush(frame, target), 0, "shift: up / left");
+
+	check_target(frame, target);
+
+	frame_free(frame);
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests.
+ *****************************************************************************/
+
+void ut_frame_exec() {
+
+	const s_point dim = { .row = 4, .col = 8 };
+
+	s_target *target = target_mem_create(&dim);
+
+	test_frame_flush(target);
+
+	target_free(target);
+
+	target = target_mem_create(&dim);
+
+	test_frame_shift(target);
+
+	target_free(target);
+}
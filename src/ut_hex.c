@@ -189,6 +189,78 @@ static void test_hex_get_hex_idx() {
 	check_hex_get_hex_idx(14, 7, -1, -1, &hex_max);
 }
 
+/******************************************************************************
+ * The function is the former implementation of hex_get_hex_idx, which splits
+ * the columns into blocks of 3 columns with separate cases for the left column
+ * and the center and right column of the block. It is the reference for the
+ * table based implementation.
+ *****************************************************************************/
+
+static void hex_get_hex_idx_ref(const int win_row, const int win_col, const s_point *hex_max, s_point *hex_idx) {
+
+	const int col_3_idx = win_col / 3;
+
+	if (win_col % 3 == 0) {
+		const int win_row_offset = win_row - 1;
+
+		if (win_row_offset < 0) {
+			s_point_set(hex_idx, -1, -1);
+
+		} else {
+			hex_idx->col = col_3_idx - ((win_row_offset / 2 + col_3_idx) % 2);
+
+			if (hex_idx->col < 0) {
+				s_point_set(hex_idx, -1, -1);
+
+			} else {
+				hex_idx->row = win_row_offset / 4;
+			}
+		}
+
+	} else {
+		const int win_row_offset = win_row - ((col_3_idx % 2 == 1) ? 2 : 0);
+
+		if (win_row_offset < 0) {
+			s_point_set(hex_idx, -1, -1);
+
+		} else {
+			hex_idx->row = win_row_offset / 4;
+			hex_idx->col = col_3_idx;
+		}
+	}
+
+	if (hex_idx->row >= hex_max->row || hex_idx->col >= hex_max->col) {
+		s_point_set(hex_idx, -1, -1);
+	}
+}
+
+/******************************************************************************
+ * The function compares hex_get_hex_idx with the reference implementation for
+ * all positions of a window, that is larger than the hex fields.
+ *****************************************************************************/
+
+static void test_hex_get_hex_idx_all() {
+	const s_point hex_max = { .row = 10, .col = 24 };
+	s_point hex_idx, hex_idx_ref;
+	int num = 0, num_same = 0;
+
+	for (int win_row = 0; win_row < hex_max.row * 4 + 8; win_row++) {
+		for (int win_col = 0; win_col < hex_max.col * 3 + 8; win_col++) {
+
+			hex_get_hex_idx(win_row, win_col, &hex_max, &hex_idx);
+			hex_get_hex_idx_ref(win_row, win_col, &hex_max, &hex_idx_ref);
+
+			num++;
+
+			if (s_point_same(&hex_idx, &hex_idx_ref)) {
+				num_same++;
+			}
+		}
+	}
+
+	ut_check_int(num_same, num, "hex idx: all");
+}
+
 /******************************************************************************
  * The function is the a wrapper, that triggers the internal unit tests.
  *****************************************************************************/
@@ -196,4 +268,6 @@ static void test_hex_get_hex_idx() {
 void ut_hex_exec() {
 
 	test_hex_get_hex_idx();
+
+	test_hex_get_hex_idx_all();
 }
@@ -22,7 +22,10 @@
  * SOFTWARE.
  */
 
+#include <string.h>
+
 #include "hg_common.h"
+#include "hg_color.h"
 #include "ut_utils.h"
 #include "hg_obj_area.h"
 
@@ -104,6 +107,377 @@ void test_obj_area_goto() {
 	test_hex(&from, DIR_NW, 2, 1);
 }
 
+/******************************************************************************
+ * The function is the former switch based implementation of obj_area_goto,
+ * which is the reference for the table driven implementation.
+ *****************************************************************************/
+
+static void goto_ref(const s_point *from, const e_dir dir, s_point *to) {
+
+	switch (dir) {
+
+	case DIR_NN:
+		to->row = from->row - 1;
+		to->col = from->col;
+		break;
+
+	case DIR_NE:
+		to->row = from->row - 1 + from->col % 2;
+		to->col = from->col + 1;
+		break;
+
+	case DIR_SE:
+		to->row = from->row + from->col % 2;
+		to->col = from->col + 1;
+		break;
+
+	case DIR_SS:
+		to->row = from->row + 1;
+		to->col = from->col;
+		break;
+
+	case DIR_SW:
+		to->row = from->row + from->col % 2;
+		to->col = from->col - 1;
+		break;
+
+	case DIR_NW:
+		to->row = from->row - 1 + from->col % 2;
+		to->col = from->col - 1;
+		break;
+
+	default:
+		log_exit("Unknown direction: %d", dir)
+		;
+	}
+}
+
+/******************************************************************************
+ * The function checks obj_area_goto and obj_area_goto_all against the
+ * reference implementation for all parities of the rows and columns.
+ *****************************************************************************/
+
+static void test_obj_area_goto_table() {
+	s_point from, to, exp;
+	s_point to_all[DIR_NUM];
+	int num = 0;
+	int num_all = 0;
+
+	for (from.row = 0; from.row < 8; from.row++) {
+		for (from.col = 0; from.col < 8; from.col++) {
+
+			obj_area_goto_all(&from, to_all);
+
+			for (e_dir dir = 0; dir < DIR_NUM; dir++) {
+
+				goto_ref(&from, dir, &exp);
+
+				obj_area_goto(&from, dir, &to);
+
+				if (s_point_same(&to, &exp)) {
+					num++;
+				}
+
+				if (s_point_same(&to_all[dir], &exp)) {
+					num_all++;
+				}
+			}
+		}
+	}
+
+	ut_check_int(num, 8 * 8 * DIR_NUM, "goto: table");
+	ut_check_int(num_all, 8 * 8 * DIR_NUM, "goto: all");
+}
+
+/******************************************************************************
+ * The function checks the adjacency table against obj_area_goto for all hex
+ * fields of a small object area, including the borders.
+ *****************************************************************************/
+
+static void test_obj_area_adjacent() {
+	const s_point dim = { .row = 5, .col = 6 };
+	s_point from, to, exp;
+	int num = 0;
+
+	obj_area_init(&dim);
+
+	for (from.row = 0; from.row < dim.row; from.row++) {
+		for (from.col = 0; from.col < dim.col; from.col++) {
+			for (e_dir dir = 0; dir < DIR_NUM; dir++) {
+
+				obj_area_goto(&from, dir, &exp);
+
+				const bool inside = obj_area_adjacent(&from, dir, &to);
+
+				if (s_point_same(&to, &exp) && inside == s_point_inside(&dim, &exp)) {
+					num++;
+				}
+			}
+		}
+	}
+
+	ut_check_int(num, dim.row * dim.col * DIR_NUM, "adjacent: all");
+
+	//
+	// The neighbours of the objects.
+	//
+	ut_check_bool(obj_area_neighbour(obj_area_get(0, 1), DIR_NE) == obj_area_get(0, 2), true, "adjacent: neighbour");
+	ut_check_bool(obj_area_neighbour(obj_area_get(0, 2), DIR_NE) == NULL, true, "adjacent: outside");
+
+	obj_area_free();
+}
+
+/******************************************************************************
+ * The function checks the list of damaged objects.
+ *****************************************************************************/
+
+static void test_obj_area_damage() {
+	const s_point dim = { .row = 3, .col = 3 };
+
+	obj_area_init(&dim);
+
+	s_object *obj_1 = obj_area_get(0, 0);
+	s_object *obj_2 = obj_area_get(1, 2);
+
+	//
+	// Damaging an object twice adds it only once.
+	//
+	obj_area_damage(obj_1);
+	obj_area_damage(obj_2);
+	obj_area_damage(obj_1);
+
+	ut_check_bool(obj_1->damaged, true, "obj 1 damaged");
+
+	ut_check_bool(obj_area_damage_next() == obj_2, true, "next: obj 2");
+	ut_check_bool(obj_area_damage_next() == obj_1, true, "next: obj 1");
+	ut_check_bool(obj_area_damage_next() == NULL, true, "next: none");
+
+	ut_check_bool(obj_1->damaged, false, "obj 1 not damaged");
+
+	//
+	// After a reset, there are no damaged objects.
+	//
+	obj_area_damage(obj_1);
+	obj_area_damage_reset();
+
+	ut_check_bool(obj_1->damaged, false, "reset obj 1");
+	ut_check_bool(obj_area_damage_next() == NULL, true, "reset: none");
+
+	obj_area_free();
+}
+
+/******************************************************************************
+ * The function checks that removing the markers resets and damages only the
+ * registered objects.
+ *****************************************************************************/
+
+static void test_obj_area_markers() {
+	const s_point dim = { .row = 100, .col = 100 };
+	s_marker marker;
+
+	obj_area_init(&dim);
+
+	s_object *obj_1 = obj_area_get(1, 1);
+	s_object *obj_2 = obj_area_get(90, 90);
+
+	//
+	// Adding a marker twice registers the object only once.
+	//
+	obj_area_add_marker(obj_1, &marker);
+	obj_area_add_marker(obj_2, &marker);
+	obj_area_add_marker(obj_1, &marker);
+
+	obj_area_rm_markers();
+
+	ut_check_bool(obj_1->marker == NULL && obj_2->marker == NULL, true, "markers: removed");
+
+	ut_check_bool(obj_area_damage_next() == obj_2, true, "markers: damaged 2");
+	ut_check_bool(obj_area_damage_next() == obj_1, true, "markers: damaged 1");
+	ut_check_bool(obj_area_damage_next() == NULL, true, "markers: damaged none");
+
+	//
+	// The list is empty after the removal.
+	//
+	obj_area_rm_markers();
+
+	ut_check_bool(obj_area_damage_next() == NULL, true, "markers: empty");
+
+	obj_area_free();
+}
+
+/******************************************************************************
+ * The function checks the loading and the eviction of the tiles.
+ *****************************************************************************/
+
+static void test_obj_area_tiles() {
+	const s_point dim = { .row = 1000, .col = 1000 };
+	const s_point vp_pos = { .row = 0, .col = 0 };
+	const s_point vp_dim = { .row = 5, .col = 12 };
+
+	obj_area_init(&dim);
+
+	ut_check_int(obj_area_tiles_num(), 0, "tiles: none");
+	ut_check_bool(obj_area_peek(500, 500) == NULL, true, "tiles: peek");
+
+	//
+	// Objects of the same tile.
+	//
+	s_object *obj = obj_area_get(500, 500);
+	obj_area_get(510, 511);
+
+	ut_check_int(obj_area_tiles_num(), 1, "tiles: one");
+	ut_check_bool(obj_area_peek(500, 500) == obj, true, "tiles: peek loaded");
+	ut_check_int(obj->pos.row, 500, "tiles: pos row");
+	ut_check_int(obj->pos.col, 500, "tiles: pos col");
+
+	//
+	// A neighbour in an other tile.
+	//
+	s_object *obj_ss = obj_area_neighbour(obj_area_get(511, 500), DIR_SS);
+
+	ut_check_int(obj_area_tiles_num(), 2, "tiles: neighbour");
+	ut_check_int(obj_ss->pos.row, 512, "tiles: neighbour row");
+	ut_check_bool(obj_area_neighbour(obj_area_get(0, 0), DIR_NN) == NULL, true, "tiles: outside");
+
+	//
+	// An object in a tile far away is not empty.
+	//
+	obj_area_get(900, 900)->obj = OBJ_SHIP;
+
+	//
+	// Load more than OBJ_AREA_TILES_MAX tiles.
+	//
+	s_point last;
+
+	for (int i = 0; i < OBJ_AREA_TILES_MAX + 10; i++) {
+		s_point_set(&last, OBJ_AREA_TILE_SIZE * (i / 40) + 200, OBJ_AREA_TILE_SIZE * (i % 40));
+		obj_area_get(last.row, last.col);
+	}
+
+	ut_check_bool(obj_area_tiles_num() > OBJ_AREA_TILES_MAX, true, "tiles: loaded");
+
+	obj_area_evict(&vp_pos, &vp_dim);
+
+	ut_check_int(obj_area_tiles_num(), OBJ_AREA_TILES_MAX, "tiles: evicted");
+
+	//
+	// The viewport and the tile with the ship are not evicted.
+	//
+	ut_check_bool(obj_area_peek(0, 0) != NULL, true, "tiles: viewport");
+	ut_check_bool(obj_area_peek(900, 900) != NULL, true, "tiles: not empty");
+
+	//
+	// The least recently used tiles are evicted first.
+	//
+	ut_check_bool(obj_area_peek(500, 500) == NULL, true, "tiles: lru");
+	ut_check_bool(obj_area_peek(last.row, last.col) != NULL, true, "tiles: recent");
+
+	obj_area_get(900, 900)->obj = OBJ_NONE;
+
+	obj_area_free();
+}
+
+/******************************************************************************
+ * The function collects the directions of the move markers of the object area
+ * and removes the markers.
+ *****************************************************************************/
+
+#define PATHS_DIM 8
+
+static void paths_collect(int dirs[PATHS_DIM][PATHS_DIM]) {
+
+	for (int row = 0; row < PATHS_DIM; row++) {
+		for (int col = 0; col < PATHS_DIM; col++) {
+			const s_object *obj = obj_area_get(row, col);
+			dirs[row][col] = obj->marker == NULL ? -2 : (int) obj->marker->marker_move->dir;
+		}
+	}
+
+	obj_area_rm_markers();
+	obj_area_damage_reset();
+	s_marker_release();
+	arena_reset(&_arena_turn);
+}
+
+/******************************************************************************
+ * The function checks that walking the path trie sets the same markers as
+ * interpreting each path string, for all positions and directions, including
+ * the borders and an occupied target.
+ *****************************************************************************/
+
+static void test_obj_area_paths() {
+	const s_point dim = { .row = PATHS_DIM, .col = PATHS_DIM };
+	int dirs_trie[PATHS_DIM][PATHS_DIM];
+	int dirs_path[PATHS_DIM][PATHS_DIM];
+	int same = 0, num = 0, markers = 0;
+
+	col_set_headless(true);
+
+	obj_area_init(&dim);
+
+	ship_field_init();
+
+	s_marker_init();
+
+	s_ship_inst *ship = s_ship_inst_create(SHIP_TYPE_NORMAL, DIR_NN);
+	s_ship_inst *block = s_ship_inst_create(SHIP_TYPE_NORMAL, DIR_NN);
+
+	s_object_set_ship_at(3, 3, block);
+
+	for (int row = 0; row < PATHS_DIM; row++) {
+		for (int col = 0; col < PATHS_DIM; col++) {
+
+			s_object *obj = obj_area_get(row, col);
+
+			if (obj->obj != OBJ_NONE) {
+				continue;
+			}
+
+			for (int dir = 0; dir < DIR_NUM; dir++) {
+				ship->dir = dir;
+				s_object_set_ship_at(row, col, ship);
+
+				obj_area_set_mv_markers(obj);
+				paths_collect(dirs_trie);
+
+				for (int i = 0; ship->ship_type->paths[i] != NULL; i++) {
+					obj_area_set_mv_marker_path(obj, ship->ship_type->paths[i]);
+				}
+				paths_collect(dirs_path);
+
+				if (memcmp(dirs_trie, dirs_path, sizeof(dirs_trie)) == 0) {
+					same++;
+				}
+				num++;
+
+				for (int i = 0; i < PATHS_DIM * PATHS_DIM; i++) {
+					if (dirs_path[i / PATHS_DIM][i % PATHS_DIM] != -2) {
+						markers++;
+					}
+				}
+
+				obj->obj = OBJ_NONE;
+				obj->ship_inst = NULL;
+			}
+		}
+	}
+
+	ut_check_int(same, num, "paths: trie same as strings");
+	ut_check_bool(markers > num, true, "paths: markers set");
+
+	s_marker_free();
+
+	ship_field_free();
+
+	obj_area_free();
+
+	arena_free(&_arena_turn);
+
+	col_color_reset();
+
+	col_set_headless(false);
+}
+
 /******************************************************************************
  * The function is the a wrapper, that triggers the internal unit tests.
  *****************************************************************************/
@@ -111,4 +485,16 @@ void test_obj_area_goto() {
 void ut_obj_area_exec() {
 
 	test_obj_area_goto();
+
+	test_obj_area_goto_table();
+
+	test_obj_area_adjacent();
+
+	test_obj_area_damage();
+
+	test_obj_area_markers();
+
+	test_obj_area_tiles();
+
+	test_obj_area_paths();
 }
@@ -0,0 +1,149 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "hg_pool.h"
+#include "ut_utils.h"
+
+/******************************************************************************
+ * The element type of the test pool.
+ *****************************************************************************/
+
+typedef struct {
+
+	int value;
+
+	double align;
+
+} s_ut_elem;
+
+#define UT_POOL_CHUNK 4
+
+/******************************************************************************
+ * The function checks that released elements are reused and that the handles
+ * of released elements are stale.
+ *****************************************************************************/
+
+static void test_pool_release() {
+	s_pool pool;
+
+	pool_init(&pool, "ut", sizeof(s_ut_elem), UT_POOL_CHUNK);
+
+	s_ut_elem *e1 = pool_alloc(&pool);
+	s_ut_elem *e2 = pool_alloc(&pool);
+
+	ut_check_int(pool.used, 2, "release: used 2");
+	ut_check_bool(e1 != e2, true, "release: different elements");
+	ut_check_bool((size_t) e1 % _Alignof(s_ut_elem) == 0, true, "release: aligned");
+
+	const s_pool_hdl hdl = pool_hdl(&pool, e1);
+
+	ut_check_bool(pool_get(&pool, hdl) == e1, true, "release: handle is live");
+	ut_check_bool(pool_is_live(&pool, e1), true, "release: element is live");
+
+	pool_release(&pool, e1);
+
+	ut_check_int(pool.used, 1, "release: used 1");
+	ut_check_bool(pool_get(&pool, hdl) == NULL, true, "release: handle is stale");
+	ut_check_bool(pool_is_live(&pool, e1), false, "release: element is released");
+
+	//
+	// The released element is reused, but the old handle stays stale.
+	//
+	s_ut_elem *e3 = pool_alloc(&pool);
+
+	ut_check_bool(e3 == e1, true, "release: element reused");
+	ut_check_bool(pool_get(&pool, hdl) == NULL, true, "release: handle of reused is stale");
+	ut_check_bool(pool_get(&pool, pool_hdl(&pool, e3)) == e3, true, "release: new handle is live");
+
+	pool_free(&pool);
+}
+
+/******************************************************************************
+ * The function checks that the pool grows beyond a chunk without moving the
+ * elements and that releasing all elements invalidates all handles.
+ *****************************************************************************/
+
+static void test_pool_grow() {
+	s_pool pool;
+	s_ut_elem *elems[UT_POOL_CHUNK * 3];
+	s_pool_hdl hdls[UT_POOL_CHUNK * 3];
+	const int num = UT_POOL_CHUNK * 3;
+
+	pool_init(&pool, "ut", sizeof(s_ut_elem), UT_POOL_CHUNK);
+
+	for (int i = 0; i < num; i++) {
+		elems[i] = pool_alloc(&pool);
+		elems[i]->value = i;
+		hdls[i] = pool_hdl(&pool, elems[i]);
+	}
+
+	ut_check_int(pool.chunk_num, 3, "grow: chunks");
+	ut_check_int(pool.used, num, "grow: used");
+
+	int stable = 0;
+
+	for (int i = 0; i < num; i++) {
+		if (pool_get(&pool, hdls[i]) == elems[i] && elems[i]->value == i) {
+			stable++;
+		}
+	}
+
+	ut_check_int(stable, num, "grow: stable pointers");
+
+	pool_release_all(&pool);
+
+	int stale = 0;
+
+	for (int i = 0; i < num; i++) {
+		if (pool_get(&pool, hdls[i]) == NULL) {
+			stale++;
+		}
+	}
+
+	ut_check_int(stale, num, "grow: all stale");
+	ut_check_int(pool.used, 0, "grow: used 0");
+
+	//
+	// After the release all elements are reused without growing.
+	//
+	for (int i = 0; i < num; i++) {
+		pool_alloc(&pool);
+	}
+
+	ut_check_int(pool.chunk_num, 3, "grow: no new chunks");
+	ut_check_int(pool.used, num, "grow: used again");
+
+	pool_free(&pool);
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests.
+ *****************************************************************************/
+
+void ut_pool_exec() {
+
+	test_pool_release();
+
+	test_pool_grow();
+}
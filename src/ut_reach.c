@@ -0,0 +1,262 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "hg_reach.h"
+#include "ut_utils.h"
+
+/******************************************************************************
+ * The definitions for the reference implementation, which enumerates all
+ * paths with a depth first search and records the cheapest cost of each
+ * state.
+ *****************************************************************************/
+
+#define UT_DIM 24
+
+#define UT_COST_NONE 1000
+
+static int _ut_cost[UT_DIM][UT_DIM][DIR_NUM];
+
+static void ut_reach_ref(const s_ship_move *move, const s_point *pos, const e_dir dir, const int cost) {
+	s_point to;
+
+	if (cost >= _ut_cost[pos->row][pos->col][dir]) {
+		return;
+	}
+
+	_ut_cost[pos->row][pos->col][dir] = cost;
+
+	for (int t = 0; t < PATH_TURN_NUM; t++) {
+		const e_dir dir_next = e_dir_mv(dir, "lcr"[t]);
+
+		if (cost + move->cost[t] > move->points || !obj_area_adjacent(pos, dir_next, &to)) {
+			continue;
+		}
+
+		const s_object *obj = obj_area_peek(to.row, to.col);
+
+		if (obj == NULL || obj->obj == OBJ_NONE) {
+			ut_reach_ref(move, &to, dir_next, cost + move->cost[t]);
+		}
+	}
+}
+
+/******************************************************************************
+ * The function compares the reachable states with the reference and replays
+ * the path of each state.
+ *****************************************************************************/
+
+static void test_reach_compare(const s_ship_move *move, const s_point *start, const e_dir dir, const char *msg) {
+	s_arena arena;
+	s_reach reach;
+	s_point pos;
+	char path[64];
+	int num_ref = 0, same = 0, replay = 0;
+
+	for (int row = 0; row < UT_DIM; row++) {
+		for (int col = 0; col < UT_DIM; col++) {
+			for (int d = 0; d < DIR_NUM; d++) {
+				_ut_cost[row][col][d] = UT_COST_NONE;
+			}
+		}
+	}
+
+	ut_reach_ref(move, start, dir, 0);
+
+	for (int row = 0; row < UT_DIM; row++) {
+		for (int col = 0; col < UT_DIM; col++) {
+			for (int d = 0; d < DIR_NUM; d++) {
+				if (_ut_cost[row][col][d] != UT_COST_NONE) {
+					num_ref++;
+				}
+			}
+		}
+	}
+
+	arena_init(&arena);
+
+	reach_compute(&arena, move, start, dir, &reach);
+
+	for (int i = 0; i < reach.num; i++) {
+		const s_reach_state *state = &reach.states[i];
+
+		if (_ut_cost[state->pos.row][state->pos.col][state->dir] == state->cost) {
+			same++;
+		}
+
+		//
+		// Replay the path and sum up the costs.
+		//
+		reach_path(&reach, i, path, sizeof(path));
+
+		s_point_copy(&pos, start);
+		e_dir d = dir;
+		int cost = 0;
+
+		for (const char *ptr = path; *ptr != '\0'; ptr++) {
+			d = e_dir_mv(d, *ptr);
+			obj_area_adjacent(&pos, d, &pos);
+			cost += move->cost[strchr("lcr", *ptr) - "lcr"];
+		}
+
+		if (s_point_same(&pos, &state->pos) && d == state->dir && cost == state->cost) {
+			replay++;
+		}
+	}
+
+	ut_check_int(reach.num, num_ref, msg);
+	ut_check_int(same, num_ref, msg);
+	ut_check_int(replay, num_ref, msg);
+
+	arena_free(&arena);
+}
+
+/******************************************************************************
+ * The function checks the reachability against the reference, in the middle
+ * of the object area, at the border and with blocking objects.
+ *****************************************************************************/
+
+static void test_reach_ref() {
+	const s_point dim = { .row = UT_DIM, .col = UT_DIM };
+	const s_ship_move move = { .points = 6, .cost = { 2, 1, 2 } };
+	const s_ship_move move_flat = { .points = 4, .cost = { 1, 1, 1 } };
+	s_ship_inst ship = { .dir = DIR_NN, .ship_type = NULL };
+	s_point start;
+
+	obj_area_init(&dim);
+
+	s_point_set(&start, 12, 12);
+	test_reach_compare(&move, &start, DIR_NN, "reach: middle");
+	test_reach_compare(&move_flat, &start, DIR_SE, "reach: middle flat");
+
+	s_point_set(&start, 0, 0);
+	test_reach_compare(&move, &start, DIR_SS, "reach: corner");
+
+	s_point_set(&start, 23, 5);
+	test_reach_compare(&move_flat, &start, DIR_NW, "reach: border");
+
+	//
+	// Objects block the hex fields in front of the ship.
+	//
+	s_object_set_ship_at(10, 12, &ship);
+	s_object_set_ship_at(11, 13, &ship);
+
+	s_point_set(&start, 12, 12);
+	test_reach_compare(&move, &start, DIR_NN, "reach: blocked");
+
+	obj_area_free();
+}
+
+/******************************************************************************
+ * The function checks simple cases: no movement points, a single step and
+ * a blocked step.
+ *****************************************************************************/
+
+static void test_reach_simple() {
+	const s_point dim = { .row = UT_DIM, .col = UT_DIM };
+	const s_point start = { .row = 5, .col = 5 };
+	s_ship_move move = { .points = 0, .cost = { 2, 1, 2 } };
+	s_ship_inst ship = { .dir = DIR_NN, .ship_type = NULL };
+	s_arena arena;
+	s_reach reach;
+	char path[8];
+
+	obj_area_init(&dim);
+	arena_init(&arena);
+
+	reach_compute(&arena, &move, &start, DIR_NN, &reach);
+
+	ut_check_int(reach.num, 1, "simple: start only");
+	ut_check_int(reach.states[0].parent, -1, "simple: start parent");
+
+	//
+	// With 1 point the ship can only go forward.
+	//
+	move.points = 1;
+	reach_compute(&arena, &move, &start, DIR_NN, &reach);
+
+	ut_check_int(reach.num, 2, "simple: one step");
+	ut_check_int(reach.states[1].pos.row, 4, "simple: one step row");
+	ut_check_int(reach.states[1].pos.col, 5, "simple: one step col");
+	ut_check_int(reach_path(&reach, 1, path, sizeof(path)), 1, "simple: path len");
+	ut_check_bool(strcmp(path, "c") == 0, true, "simple: path");
+
+	//
+	// The step is blocked by an object.
+	//
+	s_object_set_ship_at(4, 5, &ship);
+
+	reach_compute(&arena, &move, &start, DIR_NN, &reach);
+
+	ut_check_int(reach.num, 1, "simple: blocked");
+
+	arena_free(&arena);
+	obj_area_free();
+}
+
+/******************************************************************************
+ * The function checks a ship with many movement points on a large object
+ * area. The tiles are not loaded by the reachability.
+ *****************************************************************************/
+
+static void test_reach_large() {
+	const s_point dim = { .row = 1000, .col = 1000 };
+	const s_point start = { .row = 500, .col = 500 };
+	const s_ship_move move = { .points = 12, .cost = { 2, 1, 2 } };
+	s_arena arena;
+	s_reach reach;
+	int ordered = 0;
+
+	obj_area_init(&dim);
+	arena_init(&arena);
+
+	reach_compute(&arena, &move, &start, DIR_NN, &reach);
+
+	for (int i = 1; i < reach.num; i++) {
+		if (reach.states[i - 1].cost <= reach.states[i].cost && reach.states[reach.states[i].parent].cost < reach.states[i].cost) {
+			ordered++;
+		}
+	}
+
+	ut_check_bool(reach.num > 1, true, "large: states");
+	ut_check_int(ordered, reach.num - 1, "large: ordered");
+	ut_check_int(obj_area_tiles_num(), 0, "large: no tiles");
+
+	arena_free(&arena);
+	obj_area_free();
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests.
+ *****************************************************************************/
+
+void ut_reach_exec() {
+
+	test_reach_simple();
+
+	test_reach_ref();
+
+	test_reach_large();
+}
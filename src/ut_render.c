@@ -0,0 +1,207 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include <wchar.h>
+
+#include "hg_common.h"
+#include "hg_color.h"
+#include "hg_space.h"
+#include "hg_ship.h"
+#include "hg_marker.h"
+#include "hg_render.h"
+#include "ut_utils.h"
+
+/******************************************************************************
+ * The golden image of a viewport with 2x3 hex fields. The ship is at 0/1 and
+ * the cursor at 1/0. The golden image consists of the characters and the
+ * color pairs of the frame. Stars are random, so they are compared as blanks.
+ *****************************************************************************/
+
+#define GOLD_ROWS 10
+
+#define GOLD_COLS 10
+
+static const wchar_t *_gold_chr[GOLD_ROWS] = {
+	L"          ",
+	L"          ",
+	L"    \x259F\x2599    ",
+	L"   \x259F\x2588\x2588\x2599   ",
+	L"   \x259B\x259C\x259B\x259C   ",
+	L"          ",
+	L"          ",
+	L"          ",
+	L"          ",
+	L"          " };
+
+//
+// Each color pair is denoted by a letter, in the order of its first
+// occurrence. The color pair of a blank cell is denoted by '-'.
+//
+static const char *_gold_cp[GOLD_ROWS] = {
+	"-aa----aa-",
+	"aaaa--aaaa",
+	"aaaabcaaaa",
+	"-aabbccaa-",
+	"-ddeeffgg-",
+	"ddddhhgggg",
+	"ddddaagggg",
+	"-ddaaaagg-",
+	"---aaaa---",
+	"----aa----" };
+
+/******************************************************************************
+ * The function compares the memory target with the golden image.
+ *****************************************************************************/
+
+#define BUF_SIZE 64
+
+static void check_golden(const s_target *target) {
+	wchar_t line[GOLD_COLS + 1];
+	char cps[GOLD_COLS + 1];
+	char buffer[BUF_SIZE];
+
+	short cp_seen[GOLD_ROWS * GOLD_COLS];
+	int cp_num = 0;
+
+	for (int row = 0; row < GOLD_ROWS; row++) {
+
+		target_mem_line(target, row, line);
+
+		for (int col = 0; col < GOLD_COLS; col++) {
+
+			//
+			// Stars are random.
+			//
+			if (line[col] == W_STAR[0]) {
+				line[col] = W_EMPTY[0];
+			}
+
+			//
+			// Map the color pair to a letter.
+			//
+			const short cp = target_mem_cell(target, row, col)->cp;
+
+			if (cp == CELL_BLANK_CP) {
+				cps[col] = '-';
+				continue;
+			}
+
+			int idx;
+			for (idx = 0; idx < cp_num && cp_seen[idx] != cp; idx++)
+				;
+
+			if (idx == cp_num) {
+				cp_seen[cp_num++] = cp;
+			}
+
+			cps[col] = 'a' + idx;
+		}
+
+		cps[GOLD_COLS] = '\0';
+
+		snprintf(buffer, BUF_SIZE, "golden chr row: %d", row);
+		ut_check_bool(wcscmp(line, _gold_chr[row]) == 0, true, buffer);
+
+		snprintf(buffer, BUF_SIZE, "golden cp row: %d cur: %s", row, cps);
+		ut_check_bool(strcmp(cps, _gold_cp[row]) == 0, true, buffer);
+	}
+}
+
+/******************************************************************************
+ * The function renders a viewport to a memory target and compares the result
+ * with the golden image. Rendering the same objects again does not change the
+ * target, so nothing is flushed.
+ *****************************************************************************/
+
+static void test_render_golden() {
+
+	const s_viewport viewport = { .dim = { 2, 3 }, .pos = { 0, 0 }, .max = { 4, 6 } };
+
+	const s_point dim = { .row = GOLD_ROWS, .col = GOLD_COLS };
+
+	s_target *target = target_mem_create(&dim);
+
+	s_frame *frame = frame_create(&target->dim);
+
+	s_object_set_ship_at(0, 1, s_ship_inst_create(SHIP_TYPE_NORMAL, DIR_NN));
+
+	const s_object *cursor = obj_area_get(1, 0);
+
+	render_objects(frame, &viewport, cursor);
+
+	ut_check_int(frame_flush(frame, target), 72, "render: cells");
+
+	check_golden(target);
+
+	render_objects(frame, &viewport, cursor);
+
+	ut_check_int(frame_flush(frame, target), 0, "render: unchanged");
+
+	frame_free(frame);
+
+	target_free(target);
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests. The
+ * rendering is headless, so ncurses is not initialized.
+ *****************************************************************************/
+
+void ut_render_exec() {
+
+	const s_point max = { .row = 4, .col = 6 };
+
+	col_set_headless(true);
+
+	space_init((s_point*) &max);
+
+	obj_area_init(&max);
+
+	ship_field_init();
+
+	s_marker_init();
+
+	test_render_golden();
+
+	obj_area_free();
+
+	s_marker_free();
+
+	ship_field_free();
+
+	arena_free(&_arena_turn);
+
+	space_free();
+
+	//
+	// The colors are created again by the next initialization. The cached
+	// images contain the old color pairs.
+	//
+	col_color_reset();
+
+	render_cache_reset();
+
+	col_set_headless(false);
+}
@@ -0,0 +1,104 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "hg_space.h"
+#include "ut_utils.h"
+
+/******************************************************************************
+ * The function checks that the procedural stars are reproducible and depend on
+ * the seed and the position.
+ *****************************************************************************/
+
+static void test_space_stars_hash() {
+
+	int same = 0;
+	int diff_seed = 0;
+	int diff_pos = 0;
+
+	for (int row = 0; row < 100; row++) {
+		for (int col = 0; col < 100; col++) {
+
+			if (space_stars_hash(1, row, col) == space_stars_hash(1, row, col)) {
+				same++;
+			}
+
+			if (space_stars_hash(1, row, col) != space_stars_hash(2, row, col)) {
+				diff_seed++;
+			}
+
+			if (space_stars_hash(1, row, col) != space_stars_hash(1, col, row)) {
+				diff_pos++;
+			}
+		}
+	}
+
+	ut_check_int(same, 10000, "hash: same seed");
+	ut_check_bool(diff_seed > 1000, true, "hash: seed");
+	ut_check_bool(diff_pos > 1000, true, "hash: position");
+}
+
+/******************************************************************************
+ * The function checks that the procedural stars are not at the corners of the
+ * hex field and that on average 1 of 24 points is a star.
+ *****************************************************************************/
+
+static void test_space_stars_dist() {
+
+	const unsigned short corners = hex_star_bit(0, 0) | hex_star_bit(0, 3) | hex_star_bit(3, 0) | hex_star_bit(3, 3);
+
+	int stars = 0;
+	int on_corner = 0;
+
+	for (int row = 0; row < 200; row++) {
+		for (int col = 0; col < 200; col++) {
+
+			const unsigned short mask = space_stars_hash(3, row - 100, col - 100);
+
+			if (mask & corners) {
+				on_corner++;
+			}
+
+			stars += __builtin_popcount(mask);
+		}
+	}
+
+	ut_check_int(on_corner, 0, "dist: corners");
+
+	//
+	// 40000 hex fields with 12 points and a probability of 1/24 results in
+	// 20000 stars.
+	//
+	ut_check_bool(stars > 19000 && stars < 21000, true, "dist: stars");
+}
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests.
+ *****************************************************************************/
+
+void ut_space_exec() {
+
+	test_space_stars_hash();
+
+	test_space_stars_dist();
+}
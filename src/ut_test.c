@@ -29,6 +29,14 @@
 #include "ut_obj_area.h"
 #include "ut_dir.h"
 #include "ut_viewport.h"
+#include "ut_frame.h"
+#include "ut_render.h"
+#include "ut_trace.h"
+#include "ut_space.h"
+#include "ut_cube.h"
+#include "ut_pool.h"
+#include "ut_common.h"
+#include "ut_reach.h"
 
 /******************************************************************************
  * The main function delegates the call to the individual unit test functions.
@@ -46,5 +54,21 @@ int main() {
 
 	ut_viewport_exec();
 
+	ut_frame_exec();
+
+	ut_render_exec();
+
+	ut_trace_exec();
+
+	ut_space_exec();
+
+	ut_cube_exec();
+
+	ut_pool_exec();
+
+	ut_common_exec();
+
+	ut_reach_exec();
+
 	return EXIT_SUCCESS;
 }
@@ -0,0 +1,124 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020 dead-end
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "hg_trace.h"
+#include "ut_utils.h"
+
+#ifdef TRACE
+
+/******************************************************************************
+ * The function returns the number of dumped events.
+ *****************************************************************************/
+
+static int dump_num() {
+
+	FILE *file = tmpfile();
+
+	if (file == NULL) {
+		log_exit_str("Unable to create a temporary file!");
+	}
+
+	const int num = trace_dump(file);
+
+	fclose(file);
+
+	return num;
+}
+
+/******************************************************************************
+ * The function checks the filter of the events.
+ *****************************************************************************/
+
+static void test_trace_filter() {
+
+	trace_reset();
+
+	trace_event(TRACE_DEBUG, TRACE_RENDER, "render: %ld", 1);
+	trace_event_str(TRACE_INFO, TRACE_INPUT, "input");
+
+	ut_check_int(dump_num(), 2, "filter: all");
+
+	//
+	// Filter the level.
+	//
+	_trace_level = TRACE_INFO;
+
+	trace_event(TRACE_DEBUG, TRACE_RENDER, "render: %ld", 2);
+	trace_event(TRACE_WARN, TRACE_RENDER, "render: %ld", 3);
+
+	ut_check_int(dump_num(), 3, "filter: level");
+
+	//
+	// Filter the category.
+	//
+	_trace_categories = trace_category_bit(TRACE_AREA);
+
+	trace_event(TRACE_WARN, TRACE_RENDER, "render: %ld", 4);
+	trace_event(TRACE_WARN, TRACE_AREA, "area: %ld/%ld", 5, 6);
+
+	ut_check_int(dump_num(), 4, "filter: category");
+
+	_trace_level = TRACE_DEBUG;
+	_trace_categories = TRACE_CATEGORY_ALL;
+
+	trace_reset();
+
+	ut_check_int(dump_num(), 0, "filter: reset");
+}
+
+/******************************************************************************
+ * The function checks that the oldest events are overwritten, if the ring
+ * buffer is full.
+ *****************************************************************************/
+
+static void test_trace_ring() {
+
+	trace_reset();
+
+	for (int i = 0; i < TRACE_SIZE + 10; i++) {
+		trace_event(TRACE_DEBUG, TRACE_AREA, "event: %ld", i);
+	}
+
+	ut_check_int(dump_num(), TRACE_SIZE, "ring: full");
+
+	trace_reset();
+}
+
+#endif
+
+/******************************************************************************
+ * The function is the a wrapper, that triggers the internal unit tests. The
+ * tests require the trace events to be compiled in.
+ *****************************************************************************/
+
+void ut_trace_exec() {
+
+#ifdef TRACE
+
+	test_trace_filter();
+
+	test_trace_ring();
+
+#endif
+}